@@ -0,0 +1,276 @@
+#ifndef _GRAPH_H
+#define _GRAPH_H
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "../数据结构/00/PriorityQueue.h"
+#include "../数据结构/00/Vector.cpp"
+
+/*
+ * 压缩稀疏行（CSR）存储的带权图，BFS/DFS/Dijkstra/Prim 与 exp4.py 中的同名函数语义一致
+ * 顶点为 0..n-1；所有邻边按起点连续存放在三个数组中：
+ *   _offset[v] .. _offset[v+1]  顶点v的邻边在 _neighbor/_weight 中的区间
+ *   _neighbor[e], _weight[e]    第e条邻边的另一端与权重
+ * 每条邻边只占 sizeof(Rank) + sizeof(W) 字节，遍历某顶点的邻边是一段连续内存的顺序扫描
+ * 邻边总数（无向边计两次）不能超过 Rank 的上限
+ * Dijkstra、Prim 的优先级队列为模板参数，默认带索引的4叉堆，也可换用配对堆：
+ *   g.dijkstra(s)、g.dijkstra<PairingHeap>(s)
+ */
+
+/*------------------------------------------------------
+结构名称：GraphEdge<W>
+结构功能：边（u, v, 权重w）；建图的输入，也是 prim() 输出的支撑树边
+*/
+template <typename W>
+struct GraphEdge
+{
+    Rank u, v;
+    W w;
+};
+
+/*------------------------------------------------------
+类名称：Graph<W>
+类功能：CSR 带权图，W为权重类型；建成后只读
+       无向图中每条边 (u,v,w) 在u、v的邻边中各出现一次
+       各顶点的邻边次序与加边次序一致（与 exp4.py 的邻接表相同），故遍历次序也与之相同
+*/
+template <typename W = double>
+class Graph
+{
+    Rank _n;
+    Vector<Rank> _offset;   // 顶点v的邻边为 [_offset[v], _offset[v+1])
+    Vector<Rank> _neighbor; // 各邻边的另一端
+    Vector<W> _weight;      // 各邻边的权重
+
+    void checkVertex(Rank v) const // 起点越界时抛出 std::out_of_range（与建图时检查边的端点一致）
+    {
+        if (v < 0 || v >= _n)
+            throw std::out_of_range("Graph: source vertex out of range");
+    }
+
+public:
+    Graph(Rank n, Vector<GraphEdge<W>> const &edges, bool directed = false); // n个顶点，由边表建图
+
+    Rank vertexCount() const { return _n; }
+    Rank arcCount() const { return _neighbor.size(); } // 邻边总数（无向边计两次）
+    Rank firstArc(Rank v) const { return _offset[v]; } // 顶点v的邻边为 [firstArc(v), endArc(v))
+    Rank endArc(Rank v) const { return _offset[v + 1]; }
+    Rank degree(Rank v) const { return _offset[v + 1] - _offset[v]; }
+    Rank neighbor(Rank e) const { return _neighbor[e]; }
+    W weight(Rank e) const { return _weight[e]; }
+
+    static W infinity() // 不可达顶点的距离
+    {
+        return std::numeric_limits<W>::has_infinity ? std::numeric_limits<W>::infinity() : std::numeric_limits<W>::max();
+    }
+
+    template <typename VST>
+    void bfs(Rank s, VST visit) const; // 自s广度优先遍历，按访问次序调用visit(v)
+    template <typename VST>
+    void dfs(Rank s, VST visit) const; // 自s深度优先遍历，按访问次序调用visit(v)
+    template <template <typename> class PQ = QuaternaryHeap>
+    Vector<W> dijkstra(Rank s) const; // 自s到各顶点的最短距离，不可达者为infinity()
+    template <template <typename> class PQ = QuaternaryHeap>
+    Vector<GraphEdge<W>> prim(Rank s) const; // s所在连通分量的最小支撑树，按加入次序给出各边
+};
+
+/*---------------------------------------------------------
+ * 函数名称：Graph(Rank n, Vector<GraphEdge<W>> const& edges, bool directed)
+ * 函数功能：由边表建图：计数排序，两趟扫描边表
+ *          第一趟统计各顶点的出度，前缀和得到 _offset；第二趟把各邻边填入所属区间
+ *          同一顶点的邻边按边表中的次序排列
+ */
+template <typename W>
+Graph<W>::Graph(Rank n, Vector<GraphEdge<W>> const &edges, bool directed)
+    : _n(n), _offset(n + 1, n + 1, 0)
+{
+    Rank m = edges.size();
+    Rank *offset = _offset.data();
+    for (Rank i = 0; i < m; i++)
+    {
+        GraphEdge<W> const &e = edges[i];
+        if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n)
+            throw std::out_of_range("Graph: edge endpoint out of range");
+        offset[e.u + 1]++;
+        if (!directed)
+            offset[e.v + 1]++;
+    }
+    for (Rank v = 0; v < n; v++)
+        offset[v + 1] += offset[v];
+    Rank arcs = offset[n];
+    _neighbor = Vector<Rank>(arcs, arcs, 0);
+    _weight = Vector<W>(arcs, arcs, W());
+    Rank *nbr = _neighbor.data();
+    W *wt = _weight.data();
+    Vector<Rank> next(_offset, 0, n); // 各顶点下一条邻边的填入位置
+    Rank *pos = next.data();
+    for (Rank i = 0; i < m; i++)
+    { // 与 exp4.py 的 add_edge 相同：先在u的邻边末尾加v，再在v的邻边末尾加u
+        GraphEdge<W> const &e = edges[i];
+        nbr[pos[e.u]] = e.v, wt[pos[e.u]++] = e.w;
+        if (!directed)
+            nbr[pos[e.v]] = e.u, wt[pos[e.v]++] = e.w;
+    }
+}
+
+/*---------------------------------------------------------
+ * 函数名称：bfs(Rank s, VST visit) const
+ * 函数功能：广度优先遍历；队列为一个预留n个位置的向量，出队只移动队首指针
+ */
+template <typename W>
+template <typename VST>
+void Graph<W>::bfs(Rank s, VST visit) const
+{
+    checkVertex(s);
+    Vector<bool> visited(_n, _n, false);
+    Vector<Rank> queue(_n);
+    Rank head = 0;
+    queue.push_Back(s);
+    visited[s] = true;
+    while (head < queue.size())
+    {
+        Rank v = queue.at_unchecked(head++);
+        visit(v);
+        for (Rank e = _offset.at_unchecked(v), end = _offset.at_unchecked(v + 1); e < end; e++)
+        {
+            Rank u = _neighbor.at_unchecked(e);
+            if (!visited.at_unchecked(u))
+            {
+                visited.at_unchecked(u) = true;
+                queue.push_Back(u);
+            }
+        }
+    }
+}
+
+/*---------------------------------------------------------
+ * 函数名称：dfs(Rank s, VST visit) const
+ * 函数功能：深度优先遍历，访问次序与递归版本（exp4.py 的 dfs）相同
+ *          以显式栈代替递归：栈中每项为（顶点，下一条待查看的邻边），大图上不会栈溢出
+ */
+template <typename W>
+template <typename VST>
+void Graph<W>::dfs(Rank s, VST visit) const
+{
+    checkVertex(s);
+    Vector<bool> visited(_n, _n, false);
+    Vector<std::pair<Rank, Rank>> stack;
+    visited[s] = true;
+    visit(s);
+    stack.push_Back(std::make_pair(s, _offset[s]));
+    while (!stack.empty())
+    {
+        std::pair<Rank, Rank> &top = stack.at_unchecked(stack.size() - 1);
+        Rank v = top.first, end = _offset.at_unchecked(v + 1);
+        while (top.second < end && visited.at_unchecked(_neighbor.at_unchecked(top.second)))
+            top.second++;
+        if (top.second == end)
+        { // v的邻边已查看完，回溯
+            stack.remove(stack.size() - 1);
+            continue;
+        }
+        Rank u = _neighbor.at_unchecked(top.second++);
+        visited.at_unchecked(u) = true;
+        visit(u);
+        stack.push_Back(std::make_pair(u, _offset.at_unchecked(u))); // top 可能因扩容失效，此后不再使用
+    }
+}
+
+/*---------------------------------------------------------
+ * 函数名称：dijkstra<PQ>(Rank s) const
+ * 函数功能：单源最短路径（权重非负）
+ *          队列中每个未确定的顶点只占一项，键为当前距离；距离变小时 decreaseKey，
+ *          不像 exp4.py 的惰性删除那样压入重复项，队列规模不超过顶点数
+ */
+template <typename W>
+template <template <typename> class PQ>
+Vector<W> Graph<W>::dijkstra(Rank s) const
+{
+    checkVertex(s);
+    Vector<W> dist(_n, _n, infinity());
+    PQ<W> queue(_n);
+    dist[s] = W();
+    queue.push(s, W());
+    while (!queue.empty())
+    {
+        W dv = queue.topKey();
+        Rank v = queue.pop(); // dist[v]已确定
+        for (Rank e = _offset.at_unchecked(v), end = _offset.at_unchecked(v + 1); e < end; e++)
+        {
+            Rank u = _neighbor.at_unchecked(e);
+            W d = dv + _weight.at_unchecked(e);
+            if (d < dist.at_unchecked(u))
+            { // 已确定者的距离不会再变小，故u必未出队
+                dist.at_unchecked(u) = d;
+                if (queue.contains(u))
+                    queue.decreaseKey(u, d);
+                else
+                    queue.push(u, d);
+            }
+        }
+    }
+    return dist;
+}
+
+/*------------------------------------------------------
+结构名称：PrimKey<W>
+结构功能：Prim 中候选边的键：先比权重，权重相同时比加入候选集的次序（先加入者优先）
+*/
+template <typename W>
+struct PrimKey
+{
+    W w;
+    long long seq;
+    bool operator<(PrimKey const &o) const { return w < o.w || (!(o.w < w) && seq < o.seq); }
+};
+
+/*---------------------------------------------------------
+ * 函数名称：prim<PQ>(Rank s) const
+ * 函数功能：最小支撑树（Prim），只覆盖s所在的连通分量
+ *          队列中每个树外顶点只占一项：连到树上的最佳候选边（键），其树内端点记在 parent 中
+ *          exp4.py 每轮对整个候选边表排序后取首项，权重相同时取先加入者；
+ *          这里键为（权重，次序），新候选边的次序总是最大，只在权重严格更小时才替换，
+ *          队首恰是 Python 版本会取的那条边，得到的支撑树及各边的次序与之相同
+ */
+template <typename W>
+template <template <typename> class PQ>
+Vector<GraphEdge<W>> Graph<W>::prim(Rank s) const
+{
+    checkVertex(s);
+    Vector<GraphEdge<W>> mst;
+    Vector<bool> inTree(_n, _n, false);
+    Vector<Rank> parent(_n, _n, -1);
+    PQ<PrimKey<W>> queue(_n);
+    long long seq = 0;
+    auto addCandidates = [&](Rank u) { // u的邻边中通往树外者成为候选边
+        for (Rank e = _offset.at_unchecked(u), end = _offset.at_unchecked(u + 1); e < end; e++)
+        {
+            Rank v = _neighbor.at_unchecked(e);
+            if (inTree.at_unchecked(v))
+                continue;
+            PrimKey<W> k{_weight.at_unchecked(e), seq++};
+            if (!queue.contains(v))
+                queue.push(v, k);
+            else if (k < queue.key(v))
+                queue.decreaseKey(v, k);
+            else
+                continue;
+            parent.at_unchecked(v) = u;
+        }
+    };
+    inTree[s] = true;
+    addCandidates(s);
+    while (!queue.empty())
+    {
+        W w = queue.topKey().w;
+        Rank v = queue.pop();
+        inTree.at_unchecked(v) = true;
+        mst.push_Back(GraphEdge<W>{parent.at_unchecked(v), v, w});
+        addCandidates(v);
+    }
+    return mst;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <iostream>
+
+#include "Graph.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// exp4.py 的 C++ 版本：同一张图上的 BFS、DFS、Dijkstra、Prim，输出与之相同；最后在大规模随机图上计时
+
+// 生成n个顶点、m条边的随机无向图（权重取[1,100)的整数），固定种子，每次相同
+Graph<int> generateRandomGraph(Rank n, Rank m, uint64_t seed)
+{
+    Xoshiro256 rng(seed);
+    Vector<GraphEdge<int>> edges(m);
+    for (Rank i = 0; i < m; i++)
+        edges.push_Back(GraphEdge<int>{(Rank)rng.bounded(n), (Rank)rng.bounded(n), (int)rng.range(1, 100)});
+    return Graph<int>(n, edges);
+}
+
+int main()
+{
+    // 创建图并添加顶点和边：顶点A~F依次编号为0~5
+    const char names[] = "ABCDEF";
+    Vector<GraphEdge<int>> edges;
+    edges.push_Back(GraphEdge<int>{0, 1, 2}); // A - B
+    edges.push_Back(GraphEdge<int>{0, 2, 3}); // A - C
+    edges.push_Back(GraphEdge<int>{1, 3, 4}); // B - D
+    edges.push_Back(GraphEdge<int>{2, 4, 5}); // C - E
+    edges.push_Back(GraphEdge<int>{2, 5, 6}); // C - F
+    edges.push_Back(GraphEdge<int>{3, 4, 7}); // D - E
+    edges.push_Back(GraphEdge<int>{4, 5, 8}); // E - F
+    Graph<int> graph(6, edges);
+
+    cout << "广度优先搜索（BFS）遍历结果：" << endl;
+    graph.bfs(0, [&](Rank v) { cout << names[v] << " "; });
+    cout << endl;
+
+    cout << "深度优先搜索（DFS）遍历结果：" << endl;
+    graph.dfs(0, [&](Rank v) { cout << names[v] << " "; });
+    cout << endl;
+
+    cout << "从顶点'A'出发的最短路径：" << endl;
+    Vector<int> dist = graph.dijkstra(0);
+    for (Rank v = 0; v < graph.vertexCount(); v++)
+    { // 不可达者与 exp4.py 一样输出 inf
+        cout << "到顶点" << names[v] << "的最短距离为：";
+        if (dist[v] == Graph<int>::infinity())
+            cout << "inf" << endl;
+        else
+            cout << dist[v] << endl;
+    }
+    cout << endl;
+
+    cout << "以顶点'A'为起点的最小支撑树：" << endl;
+    Vector<GraphEdge<int>> mst = graph.prim(0);
+    for (Rank i = 0; i < mst.size(); i++)
+        cout << names[mst[i].u] << " - " << names[mst[i].v] << " 边的权重为：" << mst[i].w << endl;
+
+    // 规模测试
+    const Rank n = 1000000, m = 5000000;
+    auto start = steady_clock::now();
+    Graph<int> big = generateRandomGraph(n, m, 20240601);
+    auto stop = steady_clock::now();
+    cout << "\n随机图（" << n << " 个顶点，" << m << " 条边）建图: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒" << endl;
+
+    Rank reached = 0;
+    start = steady_clock::now();
+    big.bfs(0, [&](Rank) { reached++; });
+    stop = steady_clock::now();
+    cout << "BFS: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒，到达 " << reached << " 个顶点" << endl;
+
+    start = steady_clock::now();
+    Vector<int> bigDist = big.dijkstra(0);
+    stop = steady_clock::now();
+    cout << "Dijkstra（4叉堆）: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒" << endl;
+
+    start = steady_clock::now();
+    Vector<int> bigDist2 = big.dijkstra<PairingHeap>(0);
+    stop = steady_clock::now();
+    bool same = true;
+    for (Rank v = 0; v < n; v++)
+        same = same && bigDist[v] == bigDist2[v];
+    cout << "Dijkstra（配对堆）: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒，结果" << (same ? "一致" : "不一致") << endl;
+
+    start = steady_clock::now();
+    Vector<GraphEdge<int>> bigMst = big.prim(0);
+    stop = steady_clock::now();
+    long long total = 0;
+    for (Rank i = 0; i < bigMst.size(); i++)
+        total += bigMst[i].w;
+    cout << "Prim（4叉堆）: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒，支撑树 " << bigMst.size() << " 条边，总权重 " << total << endl;
+
+    start = steady_clock::now();
+    Vector<GraphEdge<int>> bigMst2 = big.prim<PairingHeap>(0);
+    stop = steady_clock::now();
+    total = 0;
+    for (Rank i = 0; i < bigMst2.size(); i++)
+        total += bigMst2[i].w;
+    cout << "Prim（配对堆）: " << duration_cast<milliseconds>(stop - start).count() << " 毫秒，支撑树 " << bigMst2.size() << " 条边，总权重 " << total << endl;
+
+    return 0;
+}
@@ -0,0 +1,375 @@
+#ifndef _SORT_BENCH_H
+#define _SORT_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "../数据结构/00/Vector.cpp"
+
+/*
+ * 排序基准测试框架
+ * 每个（排序算法，元素类型，输入分布，规模）组合：同一份输入先预热若干次，再计时多次，
+ * 每次计时前把输入复制进同一个工作向量（复制不计时），报告中位数、p99、最小值、均值与吞吐量
+ * 输入由（分布，规模，种子）确定，同一种子的两次运行测的是完全相同的数据
+ * 每次运行（含预热）后都校验结果：有序，且与输入互为排列（校验和一致），否则抛出 std::runtime_error，
+ * 结果错误的算法不会出现在报告中；校验不计时
+ */
+
+/*------------------------------------------------------
+枚举名称：BenchDist
+枚举功能：输入分布
+*/
+enum BenchDist
+{
+    DIST_ASCENDING,     // 升序
+    DIST_DESCENDING,    // 降序
+    DIST_RANDOM,        // 均匀随机，取值[0,n)
+    DIST_FEW_UNIQUE,    // 只有16种取值
+    DIST_ORGAN_PIPE,    // 前半升序、后半降序
+    DIST_NEARLY_SORTED, // 升序后随机交换1%的位置
+    DIST_COUNT
+};
+
+static inline const char *benchDistName(int d)
+{
+    static const char *names[DIST_COUNT] = {"ascending", "descending", "random", "few-unique", "organ-pipe", "nearly-sorted"};
+    return (d >= 0 && d < DIST_COUNT) ? names[d] : "?";
+}
+
+static inline int benchDistFromName(std::string const &name) // 未知名称返回-1
+{
+    for (int d = 0; d < DIST_COUNT; d++)
+        if (name == benchDistName(d))
+            return d;
+    return -1;
+}
+
+/*------------------------------------------------------
+结构名称：BenchRecord
+结构功能：记录类型的元素：8字节键 + 8字节负载，按键比较，测试非算术类型的排序路径
+*/
+struct BenchRecord
+{
+    uint64_t key;
+    uint64_t payload;
+
+    BenchRecord(uint64_t k = 0) : key(k), payload(k * 0x9e3779b97f4a7c15ull) {}
+    bool operator<(BenchRecord const &o) const { return key < o.key; }
+    bool operator>(BenchRecord const &o) const { return o.key < key; }
+    bool operator==(BenchRecord const &o) const { return key == o.key; }
+    bool operator!=(BenchRecord const &o) const { return key != o.key; }
+};
+
+/*------------------------------------------------------
+函数名称：benchFill(Vector<T>& v, Rank n, int dist, uint64_t seed)
+函数功能：按分布生成n个元素（先生成 [0,n) 中的整数键，再转换为T）
+*/
+template <typename T>
+static void benchFill(Vector<T> &v, Rank n, int dist, uint64_t seed)
+{
+    Xoshiro256 rng(seed, (uint64_t)dist);
+    v.clear();
+    v.reserve(n);
+    for (Rank i = 0; i < n; i++)
+    {
+        uint64_t k;
+        switch (dist)
+        {
+        case DIST_ASCENDING:
+            k = i;
+            break;
+        case DIST_DESCENDING:
+            k = n - i;
+            break;
+        case DIST_FEW_UNIQUE:
+            k = rng.bounded(16);
+            break;
+        case DIST_ORGAN_PIPE:
+            k = i < n / 2 ? i : n - i;
+            break;
+        case DIST_NEARLY_SORTED:
+            k = i;
+            break;
+        default:
+            k = rng.bounded(n);
+            break;
+        }
+        v.push_Back(T(k));
+    }
+    if (dist == DIST_NEARLY_SORTED)
+        for (Rank s = n / 100; s > 0; s--)
+            swap(v[(Rank)rng.bounded(n)], v[(Rank)rng.bounded(n)]);
+}
+
+/*------------------------------------------------------
+函数名称：benchKey(T const& e)
+函数功能：元素的64位标识，用于计算排列校验和：整数取值，浮点数取位模式，记录类型键与负载一并计入
+*/
+template <typename T>
+static uint64_t benchKey(T const &e) { return (uint64_t)e; }
+static inline uint64_t benchKey(double e)
+{
+    uint64_t k;
+    memcpy(&k, &e, sizeof(k));
+    return k;
+}
+static inline uint64_t benchKey(BenchRecord const &e) { return e.key ^ (e.payload * 0xbf58476d1ce4e5b9ull); }
+
+/*------------------------------------------------------
+结构名称：BenchChecksum
+结构功能：与次序无关的多重集校验和：各元素标识之和，及其经 SplitMix64 混合后之和
+         结果是输入的一个排列时二者必然相等；丢失、重复或改写元素时几乎必然不等
+*/
+struct BenchChecksum
+{
+    uint64_t sum = 0, mixed = 0;
+
+    template <typename T>
+    explicit BenchChecksum(Vector<T> const &v)
+    {
+        for (Rank i = 0; i < v.size(); i++)
+        {
+            uint64_t k = benchKey(v[i]);
+            sum += k;
+            mixed += splitMix64(k);
+        }
+    }
+    bool operator==(BenchChecksum const &o) const { return sum == o.sum && mixed == o.mixed; }
+    bool operator!=(BenchChecksum const &o) const { return !(*this == o); }
+};
+
+/*------------------------------------------------------
+函数名称：benchVerify(Vector<T> const& out, Rank n, BenchChecksum const& expected)
+函数功能：校验排序结果：规模为n、非降、校验和与输入一致；通过返回空串，否则返回错误描述
+*/
+template <typename T>
+static std::string benchVerify(Vector<T> const &out, Rank n, BenchChecksum const &expected)
+{
+    if (out.size() != n)
+        return "size changed from " + std::to_string(n) + " to " + std::to_string(out.size());
+    for (Rank i = 1; i < n; i++)
+        if (out[i] < out[i - 1])
+            return "not sorted at rank " + std::to_string(i);
+    if (BenchChecksum(out) != expected)
+        return "output is not a permutation of the input (checksum mismatch)";
+    return "";
+}
+
+/*------------------------------------------------------
+结构名称：BenchEngine<T>
+结构功能：参与测试的一个排序算法：名称、排序函数（整体排序传入的向量），以及适用的最大规模
+         （平方级算法在大规模上跑不完，超过maxN的规模跳过）
+*/
+template <typename T>
+struct BenchEngine
+{
+    std::string name;
+    std::function<void(Vector<T> &)> sort;
+    Rank maxN;
+
+    BenchEngine(std::string nm = "", std::function<void(Vector<T> &)> fn = nullptr, Rank m = std::numeric_limits<Rank>::max())
+        : name(nm), sort(fn), maxN(m) {}
+};
+
+/*------------------------------------------------------
+函数名称：vectorEngines<T>()
+函数功能：Vector<T>自带的各个排序算法；基数排序只列入 RadixTraits 支持的类型
+         （其余类型上 sort(5) 实际是快速排序，列为 radix 会张冠李戴）
+*/
+template <typename T>
+static Vector<BenchEngine<T>> vectorEngines()
+{
+    Vector<BenchEngine<T>> e;
+    e.push_Back(BenchEngine<T>("bubble", [](Vector<T> &v) { v.sort(1); }, 10000));
+    e.push_Back(BenchEngine<T>("merge", [](Vector<T> &v) { v.sort(3); }));
+    e.push_Back(BenchEngine<T>("heap", [](Vector<T> &v) { v.sort(4); }));
+    if (RadixTraits<T>::enabled)
+        e.push_Back(BenchEngine<T>("radix", [](Vector<T> &v) { v.sort(5); }));
+    e.push_Back(BenchEngine<T>("parallel", [](Vector<T> &v) { v.sort(6); }));
+    e.push_Back(BenchEngine<T>("natural", [](Vector<T> &v) { v.sort(7); }));
+    e.push_Back(BenchEngine<T>("default", [](Vector<T> &v) { v.unstableSort(); }));
+    e.push_Back(BenchEngine<T>("stable", [](Vector<T> &v) { v.stableSort(); }));
+    return e;
+}
+
+/*------------------------------------------------------
+结构名称：BenchOptions
+结构功能：测试参数；reps为0时按规模自动选取（小规模多测几次，降低计时噪声）
+*/
+struct BenchOptions
+{
+    Vector<Rank> sizes;
+    Vector<int> dists;
+    int warmup = 1;
+    int reps = 0;
+    uint64_t seed = 20240601;
+
+    int repsFor(Rank n) const
+    {
+        if (reps > 0)
+            return reps;
+        return n <= 10000 ? 51 : n <= 1000000 ? 11 : 5;
+    }
+};
+
+/*------------------------------------------------------
+结构名称：BenchResult
+结构功能：一个组合的测试结果，时间单位为纳秒，吞吐量为每秒排序的元素数（按中位数计）
+*/
+struct BenchResult
+{
+    std::string engine, type, dist;
+    Rank n = 0;
+    int reps = 0;
+    double minNs = 0, medianNs = 0, p99Ns = 0, meanNs = 0;
+    double throughput = 0;
+};
+
+/*------------------------------------------------------
+函数名称：benchStats(Vector<double>& ns, BenchResult& r)
+函数功能：由各次计时求统计量；p99 取最近秩（nearest-rank），次数不足100时即为最大值
+*/
+static inline void benchStats(Vector<double> &ns, BenchResult &r)
+{
+    Rank m = ns.size();
+    ns.sort(0);
+    double sum = 0;
+    for (Rank i = 0; i < m; i++)
+        sum += ns[i];
+    r.reps = m;
+    r.minNs = ns[0];
+    r.medianNs = (m & 1) ? ns[m / 2] : (ns[m / 2 - 1] + ns[m / 2]) / 2;
+    Rank k = (Rank)((99LL * m + 99) / 100) - 1; // ceil(0.99m) - 1
+    r.p99Ns = ns[k < m ? k : m - 1];
+    r.meanNs = sum / m;
+    r.throughput = r.medianNs > 0 ? r.n / (r.medianNs * 1e-9) : 0;
+}
+
+/*------------------------------------------------------
+函数名称：benchMeasure(BenchEngine<T> const& e, Vector<T> const& input, int warmup, int reps)
+函数功能：对同一输入预热warmup次、计时reps次；每次计时前输入复制进工作向量，复制不计时
+         每次运行后校验结果，错误时抛出 std::runtime_error
+*/
+template <typename T>
+static Vector<double> benchMeasure(BenchEngine<T> const &e, Vector<T> const &input, int warmup, int reps)
+{
+    Rank n = input.size();
+    Vector<T> work(n > 0 ? n : 1);
+    Vector<double> ns(reps > 0 ? reps : 1);
+    BenchChecksum expected(input);
+    for (int r = -warmup; r < reps; r++)
+    {
+        work.clear();
+        work.insert(0, input.begin(), input.end());
+        auto t0 = std::chrono::steady_clock::now();
+        e.sort(work);
+        auto t1 = std::chrono::steady_clock::now();
+        std::string error = benchVerify(work, n, expected);
+        if (!error.empty())
+            throw std::runtime_error(e.name + " n=" + std::to_string(n) + ": " + error);
+        if (r >= 0)
+            ns.push_Back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    return ns;
+}
+
+/*------------------------------------------------------
+函数名称：benchRun(char const* type, Vector<BenchEngine<T>> const& engines, BenchOptions const& opt, Vector<BenchResult>& out)
+函数功能：遍历（规模，分布，算法）的全部组合，结果追加到out；每完成一项向log输出一行进度（log可为空）
+         某算法结果错误时抛出 std::runtime_error，消息中带上元素类型与分布
+*/
+template <typename T>
+static void benchRun(char const *type, Vector<BenchEngine<T>> const &engines, BenchOptions const &opt,
+                     Vector<BenchResult> &out, std::ostream *log = nullptr)
+{
+    Vector<T> input;
+    for (Rank s = 0; s < opt.sizes.size(); s++)
+    {
+        Rank n = opt.sizes[s];
+        for (Rank d = 0; d < opt.dists.size(); d++)
+        {
+            int dist = opt.dists[d];
+            benchFill(input, n, dist, opt.seed);
+            for (Rank k = 0; k < engines.size(); k++)
+            {
+                BenchEngine<T> const &e = engines[k];
+                if (n > e.maxN)
+                    continue;
+                Vector<double> ns;
+                try
+                {
+                    ns = benchMeasure(e, input, opt.warmup, opt.repsFor(n));
+                }
+                catch (std::runtime_error const &err)
+                {
+                    throw std::runtime_error(std::string(type) + " " + benchDistName(dist) + " " + err.what());
+                }
+                BenchResult r;
+                r.engine = e.name, r.type = type, r.dist = benchDistName(dist), r.n = n;
+                benchStats(ns, r);
+                out.push_Back(r);
+                if (log)
+                    *log << type << " " << r.dist << " n=" << n << " " << e.name << ": median "
+                         << r.medianNs / 1e6 << " ms" << std::endl;
+            }
+        }
+    }
+}
+
+// 输出
+
+static inline void benchWriteTable(std::ostream &os, Vector<BenchResult> const &rs)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "%-12s %-8s %-14s %11s %5s %13s %13s %13s %14s\n",
+             "engine", "type", "dist", "n", "reps", "median(ms)", "p99(ms)", "min(ms)", "Melem/s");
+    os << line;
+    for (Rank i = 0; i < rs.size(); i++)
+    {
+        BenchResult const &r = rs[i];
+        snprintf(line, sizeof(line), "%-12s %-8s %-14s %11d %5d %13.4f %13.4f %13.4f %14.2f\n",
+                 r.engine.c_str(), r.type.c_str(), r.dist.c_str(), r.n, r.reps,
+                 r.medianNs / 1e6, r.p99Ns / 1e6, r.minNs / 1e6, r.throughput / 1e6);
+        os << line;
+    }
+}
+
+static inline void benchWriteCsv(std::ostream &os, Vector<BenchResult> const &rs)
+{
+    os << "engine,type,dist,n,reps,min_ns,median_ns,p99_ns,mean_ns,elements_per_s\n";
+    char line[256];
+    for (Rank i = 0; i < rs.size(); i++)
+    {
+        BenchResult const &r = rs[i];
+        snprintf(line, sizeof(line), "%s,%s,%s,%d,%d,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+                 r.engine.c_str(), r.type.c_str(), r.dist.c_str(), r.n, r.reps,
+                 r.minNs, r.medianNs, r.p99Ns, r.meanNs, r.throughput);
+        os << line;
+    }
+}
+
+static inline void benchWriteJson(std::ostream &os, Vector<BenchResult> const &rs)
+{ // 名称均为内部给定的ASCII标识，无需转义
+    os << "[\n";
+    char line[512];
+    for (Rank i = 0; i < rs.size(); i++)
+    {
+        BenchResult const &r = rs[i];
+        snprintf(line, sizeof(line),
+                 "  {\"engine\": \"%s\", \"type\": \"%s\", \"dist\": \"%s\", \"n\": %d, \"reps\": %d, "
+                 "\"min_ns\": %.0f, \"median_ns\": %.0f, \"p99_ns\": %.0f, \"mean_ns\": %.0f, \"elements_per_s\": %.0f}%s\n",
+                 r.engine.c_str(), r.type.c_str(), r.dist.c_str(), r.n, r.reps,
+                 r.minNs, r.medianNs, r.p99Ns, r.meanNs, r.throughput, i + 1 < rs.size() ? "," : "");
+        os << line;
+    }
+    os << "]\n";
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <iostream>
-#include "../utilities/vector/Vector.hpp"
+#include <cstdlib>
+#include "SortBench.h"
 #include <algorithm>
 #include <chrono>
 
@@ -45,26 +46,30 @@ void selectionSort(Vector<int>& arr) {
 }
 
 // 鲢
-void merge(Vector<int>& arr, int left, int mid, int right) {
-    int n1 = mid - left + 1, n2 = right - mid;
-    Vector<int> L(n1), R(n2);
+// LݴεĻһ
+void merge(Vector<int>& arr, int left, int mid, int right, int* L) {
+    int n1 = mid - left + 1;
     for (int i = 0; i < n1; ++i) L[i] = arr[left + i];
-    for (int i = 0; i < n2; ++i) R[i] = arr[mid + 1 + i];
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) arr[k++] = (L[i] <= R[j]) ? L[i++] : R[j++];
+    int i = 0, j = mid + 1, k = left;
+    while (i < n1 && j <= right) arr[k++] = (L[i] <= arr[j]) ? L[i++] : arr[j++];
     while (i < n1) arr[k++] = L[i++];
-    while (j < n2) arr[k++] = R[j++];
 }
 
-void mergeSort(Vector<int>& arr, int left, int right) {
+void mergeSort(Vector<int>& arr, int left, int right, int* L) {
     if (left < right) {
         int mid = left + (right - left) / 2;
-        mergeSort(arr, left, mid);
-        mergeSort(arr, mid + 1, right);
-        merge(arr, left, mid, right);
+        mergeSort(arr, left, mid, L);
+        mergeSort(arr, mid + 1, right, L);
+        if (arr[mid + 1] < arr[mid]) merge(arr, left, mid, right, L);
     }
 }
 
+void mergeSort(Vector<int>& arr, int left, int right) {
+    int* L = new int[(right - left + 2) / 2 + 1];
+    mergeSort(arr, left, right, L);
+    delete[] L;
+}
+
 // 
 int partition(Vector<int>& arr, int low, int high) {
     int pivot = arr[high];
@@ -104,25 +109,33 @@ void heapSort(Vector<int>& arr) {
     }
 }
 
-// ܲ
+// ܲԣԤ1Ρʱ5ΣÿĶarrһݸƲʱλp99
+// ÿУΪԭУ沢˳
+// ȫĲԣֹģֲԪͣCSV/JSON sortbench.cpp
 void testSort(void (*sortFunc)(Vector<int>&), Vector<int>& arr, const string& name) {
-    Vector<int> temp = arr;
-    auto start = high_resolution_clock::now();
-    sortFunc(temp);
-    auto stop = high_resolution_clock::now();
-    auto duration = duration_cast<microseconds>(stop - start);
-    cout << name << ": " << duration.count()  << " ΢" << endl;
+    BenchResult r;
+    r.n = arr.size();
+    Vector<double> ns;
+    try {
+        ns = benchMeasure(BenchEngine<int>(name, sortFunc), arr, 1, 5);
+    } catch (const runtime_error& err) {
+        cerr << ": " << err.what() << endl;
+        exit(1);
+    }
+    benchStats(ns, r);
+    cout << name << ": λ " << r.medianNs / 1000 << " ΢, p99 " << r.p99Ns / 1000 << " ΢" << endl;
 }
 
 int main() {
     const int n = 10000; // С
     Vector<int> ascending(n), descending(n), random(n);
+    Xoshiro256 rng(20240601); // ̶ӣÿеͬɱ
 
     // ʼ
     for (int i = 0; i < n; ++i) {
         ascending.push_Back(i);
         descending.push_Back(n-i);
-        random.push_Back(rand() % n); 
+        random.push_Back((int)rng.bounded(n));
     }
 
     // Խ
@@ -133,6 +146,8 @@ int main() {
     testSort([](Vector<int>& arr) { mergeSort(arr, 0, arr.size() - 1); }, ascending, "鲢");
     testSort([](Vector<int>& arr) { quickSort(arr, 0, arr.size() - 1); }, ascending, "");
     testSort(heapSort, ascending, "");
+    testSort([](Vector<int>& arr) { arr.sort(5); }, ascending, "");
+    testSort([](Vector<int>& arr) { arr.sort(7); }, ascending, "Ȼ鲢");
 
     cout << "\nϵܲ:" << endl;
     testSort(bubbleSort, descending, "");
@@ -141,6 +156,8 @@ int main() {
     testSort([](Vector<int>& arr) { mergeSort(arr, 0, arr.size() - 1); }, descending, "鲢");
     testSort([](Vector<int>& arr) { quickSort(arr, 0, arr.size() - 1); }, descending, "");
     testSort(heapSort, descending, "");
+    testSort([](Vector<int>& arr) { arr.sort(5); }, descending, "");
+    testSort([](Vector<int>& arr) { arr.sort(7); }, descending, "Ȼ鲢");
 
     cout << "\nϵܲ:" << endl;
     testSort(bubbleSort, random, "");
@@ -149,9 +166,8 @@ int main() {
     testSort([](Vector<int>& arr) { mergeSort(arr, 0, arr.size() - 1); }, random, "鲢");
     testSort([](Vector<int>& arr) { quickSort(arr, 0, arr.size() - 1); }, random, "");
     testSort(heapSort, random, "");
-
-    system("pause");
-    
+    testSort([](Vector<int>& arr) { arr.sort(5); }, random, "");
+    testSort([](Vector<int>& arr) { arr.sort(7); }, random, "Ȼ鲢");
 
     return 0;
 }
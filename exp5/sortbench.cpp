@@ -0,0 +1,166 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "SortBench.h"
+
+/*
+ * 排序基准测试程序
+ * 用法：sortbench [选项]
+ *   --sizes=1e3,1e4,...   规模列表（默认 1e3,1e4,1e5,1e6；可到 1e8，注意内存为规模的两倍以上）
+ *   --dists=random,...    分布：ascending descending random few-unique organ-pipe nearly-sorted（默认全部）
+ *   --types=int32,...     元素类型：int32 uint64 double record（默认全部）
+ *   --engines=merge,...   排序算法：bubble merge heap radix parallel natural default stable（默认全部）
+ *   --warmup=N --reps=N   预热与计时次数（reps默认按规模自动选取）
+ *   --seed=N              输入数据的种子
+ *   --format=table|csv|json  输出格式（默认table）
+ *   --out=文件            结果写入文件（默认标准输出）；进度写到标准错误，-q 关闭
+ * 每次运行后校验排序结果，任一算法结果错误即报告错误并以返回值1退出，不输出任何结果
+ * 例：sortbench --sizes=1e6 --types=int32 --format=csv --out=base.csv
+ * 以 -DVECTOR_PERF=1 编译时，结束后在标准错误输出各 Vector 操作的硬件/软件计数（见 PerfCounters.h）
+ */
+
+static Vector<std::string> splitList(std::string const &s)
+{
+    Vector<std::string> items;
+    size_t start = 0;
+    while (start <= s.size())
+    {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos)
+            comma = s.size();
+        if (comma > start)
+            items.push_Back(s.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return items;
+}
+
+static bool listHas(Vector<std::string> const &list, std::string const &name) // 空列表表示不筛选
+{
+    if (list.empty())
+        return true;
+    for (Rank i = 0; i < list.size(); i++)
+        if (list[i] == name)
+            return true;
+    return false;
+}
+
+template <typename T>
+static void runType(char const *type, Vector<std::string> const &types, Vector<std::string> const &engineNames,
+                    BenchOptions const &opt, Vector<BenchResult> &out, std::ostream *log)
+{
+    if (!listHas(types, type))
+        return;
+    Vector<BenchEngine<T>> all = vectorEngines<T>(), engines;
+    for (Rank i = 0; i < all.size(); i++)
+        if (listHas(engineNames, all[i].name))
+            engines.push_Back(all[i]);
+    benchRun<T>(type, engines, opt, out, log);
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions opt;
+    Vector<std::string> types, engineNames;
+    std::string format = "table", outPath;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq), value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--sizes")
+        {
+            Vector<std::string> items = splitList(value);
+            for (Rank k = 0; k < items.size(); k++)
+                opt.sizes.push_Back((Rank)std::strtod(items[k].c_str(), nullptr));
+        }
+        else if (key == "--dists")
+        {
+            Vector<std::string> items = splitList(value);
+            for (Rank k = 0; k < items.size(); k++)
+            {
+                int d = benchDistFromName(items[k]);
+                if (d < 0)
+                {
+                    std::cerr << "unknown distribution: " << items[k] << std::endl;
+                    return 2;
+                }
+                opt.dists.push_Back(d);
+            }
+        }
+        else if (key == "--types")
+            types = splitList(value);
+        else if (key == "--engines")
+            engineNames = splitList(value);
+        else if (key == "--warmup")
+            opt.warmup = std::atoi(value.c_str());
+        else if (key == "--reps")
+            opt.reps = std::atoi(value.c_str());
+        else if (key == "--seed")
+            opt.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (key == "--format")
+            format = value;
+        else if (key == "--out")
+            outPath = value;
+        else if (key == "-q")
+            quiet = true;
+        else
+        {
+            std::cerr << "unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+    if (format != "table" && format != "csv" && format != "json")
+    {
+        std::cerr << "unknown format: " << format << std::endl;
+        return 2;
+    }
+    if (opt.sizes.empty())
+        for (Rank n = 1000; n <= 1000000; n *= 10)
+            opt.sizes.push_Back(n);
+    if (opt.dists.empty())
+        for (int d = 0; d < DIST_COUNT; d++)
+            opt.dists.push_Back(d);
+
+    Vector<BenchResult> results;
+    std::ostream *log = quiet ? nullptr : &std::cerr;
+    try
+    {
+        runType<int>("int32", types, engineNames, opt, results, log);
+        runType<unsigned long long>("uint64", types, engineNames, opt, results, log);
+        runType<double>("double", types, engineNames, opt, results, log);
+        runType<BenchRecord>("record", types, engineNames, opt, results, log);
+    }
+    catch (std::runtime_error const &err)
+    {
+        std::cerr << "FAILED: " << err.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outPath.empty())
+    {
+        file.open(outPath);
+        if (!file)
+        {
+            std::cerr << "cannot open " << outPath << std::endl;
+            return 2;
+        }
+    }
+    std::ostream &os = outPath.empty() ? std::cout : file;
+    if (format == "csv")
+        benchWriteCsv(os, results);
+    else if (format == "json")
+        benchWriteJson(os, results);
+    else
+        benchWriteTable(os, results);
+#if VECTOR_PERF
+    PerfRegistry::instance().report(std::cerr);
+#endif
+    return 0;
+}
@@ -0,0 +1,242 @@
+#ifndef _ARENA_ALLOCATOR_H
+#define _ARENA_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+/*------------------------------------------------------
+类名称：MonotonicArena
+类功能：单调竞技场：按块向系统申请空间，块内只做指针递增分配，不支持逐个释放，
+       release() 时一次性归还全部空间
+       适合生命期一致的短期数据（如单次请求、单次查询中的临时向量）
+       非线程安全；每个线程可用 local() 取得自己的竞技场
+*/
+class MonotonicArena
+{
+    struct Block
+    {
+        Block *next;
+        size_t size; // 块中可用字节数（不含块头）
+    };
+
+    Block *_head;      // 已申请的块（链表，最新者在前）
+    char *_cur, *_end; // 当前块中尚未分配的空间[_cur,_end)
+    size_t _blockSize; // 默认块大小
+
+    static size_t alignUp(size_t x, size_t align) { return (x + align - 1) & ~(align - 1); }
+
+public:
+    explicit MonotonicArena(size_t blockSize = 64 * 1024)
+        : _head(nullptr), _cur(nullptr), _end(nullptr), _blockSize(blockSize) {}
+    ~MonotonicArena() { release(); }
+
+    MonotonicArena(MonotonicArena const &) = delete;
+    MonotonicArena &operator=(MonotonicArena const &) = delete;
+
+    void *allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+    void release(); // 归还全部空间，此前分配出的指针全部失效
+
+    static MonotonicArena &local(); // 当前线程的竞技场
+};
+
+/*------------------------------------------------------
+函数名称：allocate(size_t bytes, size_t align)
+函数功能：从当前块切出对齐后的bytes字节；不够则另申请一块（至少容纳本次请求）
+*/
+inline void *MonotonicArena::allocate(size_t bytes, size_t align)
+{
+    size_t p = alignUp((size_t)_cur, align);
+    if (!_cur || p + bytes > (size_t)_end)
+    { // 当前块不够用
+        size_t need = bytes + align;
+        size_t size = need > _blockSize ? need : _blockSize;
+        Block *b = static_cast<Block *>(::operator new(sizeof(Block) + size));
+        b->next = _head, b->size = size;
+        _head = b;
+        _cur = reinterpret_cast<char *>(b + 1);
+        _end = _cur + size;
+        p = alignUp((size_t)_cur, align);
+    }
+    _cur = reinterpret_cast<char *>(p + bytes);
+    return reinterpret_cast<void *>(p);
+}
+
+inline void MonotonicArena::release()
+{
+    while (_head)
+    {
+        Block *b = _head;
+        _head = b->next;
+        ::operator delete(b);
+    }
+    _cur = _end = nullptr;
+}
+
+inline MonotonicArena &MonotonicArena::local()
+{
+    static thread_local MonotonicArena arena;
+    return arena;
+}
+
+/*------------------------------------------------------
+类名称：ArenaAllocator<T>
+类功能：从 MonotonicArena 分配的分配器，可作为 Vector<T, Alloc> 的 Alloc
+       deallocate 不做任何事，空间在竞技场 release() 时统一归还
+       默认构造时使用当前线程的竞技场
+*/
+template <typename T>
+struct ArenaAllocator
+{
+    typedef T value_type;
+    MonotonicArena *_arena;
+
+    ArenaAllocator() : _arena(&MonotonicArena::local()) {}
+    ArenaAllocator(MonotonicArena &arena) : _arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const &o) : _arena(o._arena) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) {} // 单调分配：逐个释放无意义
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const &a, ArenaAllocator<U> const &b) { return a._arena == b._arena; }
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const &a, ArenaAllocator<U> const &b) { return a._arena != b._arena; }
+
+/*------------------------------------------------------
+类名称：SizeClassPool
+类功能：按大小分级的内存池：16B、32B、...、64KB 共13级，每级一条空闲链表
+       请求向上取整到所在级别，释放时挂回该级链表，供下次复用，不归还系统
+       超过64KB的请求直接交给 ::operator new/delete
+       非线程安全；每个线程可用 local() 取得自己的内存池，
+       从某线程内存池取得的空间须在该线程结束前释放
+*/
+class SizeClassPool
+{
+    static const int CLASSES = 13;               // 16B << 0 .. 16B << 12
+    static const size_t MIN_BLOCK = 16;          // 最小块
+    static const size_t CHUNK_SIZE = 256 * 1024; // 每次向系统申请的大块
+
+    struct FreeNode
+    {
+        FreeNode *next;
+    };
+    struct Chunk
+    {
+        Chunk *next;
+    };
+
+    FreeNode *_free[CLASSES]; // 各级空闲链表
+    Chunk *_chunks;           // 已申请的大块（链表）
+
+    static int classOf(size_t bytes) // 容纳bytes所需的最小级别，超出范围返回-1
+    {
+        size_t size = MIN_BLOCK;
+        for (int c = 0; c < CLASSES; c++, size <<= 1)
+            if (bytes <= size)
+                return c;
+        return -1;
+    }
+    void refill(int c); // 切一个大块补充第c级空闲链表
+
+public:
+    SizeClassPool() : _chunks(nullptr)
+    {
+        for (int c = 0; c < CLASSES; c++)
+            _free[c] = nullptr;
+    }
+    ~SizeClassPool()
+    {
+        while (_chunks)
+        {
+            Chunk *k = _chunks;
+            _chunks = k->next;
+            ::operator delete(k);
+        }
+    }
+
+    SizeClassPool(SizeClassPool const &) = delete;
+    SizeClassPool &operator=(SizeClassPool const &) = delete;
+
+    void *allocate(size_t bytes);
+    void deallocate(void *p, size_t bytes);
+
+    static SizeClassPool &local(); // 当前线程的内存池
+};
+
+inline void SizeClassPool::refill(int c)
+{
+    size_t size = MIN_BLOCK << c;
+    size_t header = alignof(std::max_align_t) > sizeof(Chunk) ? alignof(std::max_align_t) : sizeof(Chunk);
+    Chunk *k = static_cast<Chunk *>(::operator new(header + CHUNK_SIZE));
+    k->next = _chunks;
+    _chunks = k;
+    char *p = reinterpret_cast<char *>(k) + header;
+    for (size_t off = 0; off + size <= CHUNK_SIZE; off += size)
+    { // 大块等分后逐个挂入空闲链表
+        FreeNode *node = reinterpret_cast<FreeNode *>(p + off);
+        node->next = _free[c];
+        _free[c] = node;
+    }
+}
+
+inline void *SizeClassPool::allocate(size_t bytes)
+{
+    int c = classOf(bytes);
+    if (c < 0)
+        return ::operator new(bytes); // 大块直接向系统申请
+    if (!_free[c])
+        refill(c);
+    FreeNode *node = _free[c];
+    _free[c] = node->next;
+    return node;
+}
+
+inline void SizeClassPool::deallocate(void *p, size_t bytes)
+{
+    if (!p)
+        return;
+    int c = classOf(bytes);
+    if (c < 0)
+    {
+        ::operator delete(p);
+        return;
+    }
+    FreeNode *node = static_cast<FreeNode *>(p);
+    node->next = _free[c];
+    _free[c] = node;
+}
+
+inline SizeClassPool &SizeClassPool::local()
+{
+    static thread_local SizeClassPool pool;
+    return pool;
+}
+
+/*------------------------------------------------------
+类名称：PoolAllocator<T>
+类功能：从 SizeClassPool 分配的分配器，可作为 Vector<T, Alloc> 的 Alloc
+       默认构造时使用当前线程的内存池
+*/
+template <typename T>
+struct PoolAllocator
+{
+    typedef T value_type;
+    SizeClassPool *_pool;
+
+    PoolAllocator() : _pool(&SizeClassPool::local()) {}
+    PoolAllocator(SizeClassPool &pool) : _pool(&pool) {}
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const &o) : _pool(o._pool) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(_pool->allocate(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) { _pool->deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(PoolAllocator<T> const &a, PoolAllocator<U> const &b) { return a._pool == b._pool; }
+template <typename T, typename U>
+bool operator!=(PoolAllocator<T> const &a, PoolAllocator<U> const &b) { return a._pool != b._pool; }
+
+#endif
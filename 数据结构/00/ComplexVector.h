@@ -0,0 +1,281 @@
+#ifndef _COMPLEX_VECTOR_H
+#define _COMPLEX_VECTOR_H
+
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include "Vector.cpp"
+#include "VectorSimd.h"
+
+#define COMPLEX_ALIGN 32 // 各列按32字节对齐，AVX2一次处理4个double
+
+/*------------------------------------------------------
+类名称：ComplexVector
+类功能：按列存放（SoA）的复数向量：实部、虚部、模的平方各占一个连续数组
+       按模筛选、按模排序时只需顺序扫描模平方一列（8字节/元素），
+       不必跨过整个复数对象；模平方在插入时算好，随元素一同搬动
+       所有改动元素的操作都同步维护三列，保证 norm(r) == real(r)^2 + imag(r)^2
+*/
+class ComplexVector
+{
+    Rank _size, _capacity;
+    double *_re, *_im, *_norm; // 实部、虚部、模的平方
+
+    static double *allocColumn(Rank c) { return static_cast<double *>(::operator new(c * sizeof(double), std::align_val_t(COMPLEX_ALIGN))); }
+    static void freeColumn(double *p) { ::operator delete(p, std::align_val_t(COMPLEX_ALIGN)); }
+    void reallocate(Rank c); // 三列换用容量为c的新空间
+
+public:
+    explicit ComplexVector(Rank c = DEFAULT_CAPACITY)
+        : _size(0), _capacity(c < 1 ? 1 : c)
+    {
+        _re = allocColumn(_capacity), _im = allocColumn(_capacity), _norm = allocColumn(_capacity);
+    }
+    ComplexVector(double const *re, double const *im, Rank n); // 由实部、虚部数组构造，模平方批量计算
+    ComplexVector(ComplexVector const &V);
+    ComplexVector(ComplexVector &&V) noexcept : _size(V._size), _capacity(V._capacity), _re(V._re), _im(V._im), _norm(V._norm)
+    {
+        V._re = V._im = V._norm = nullptr;
+        V._size = V._capacity = 0;
+    }
+    ComplexVector &operator=(ComplexVector const &V);
+    ComplexVector &operator=(ComplexVector &&V) noexcept;
+    ~ComplexVector() { freeColumn(_re), freeColumn(_im), freeColumn(_norm); }
+
+    // 只读访问接口
+    Rank size() const { return _size; }
+    bool empty() const { return !_size; }
+    double real(Rank r) const { return _re[r]; }
+    double imag(Rank r) const { return _im[r]; }
+    double norm(Rank r) const { return _norm[r]; } // 模的平方
+    double magnitude(Rank r) const { return std::sqrt(_norm[r]); }
+    double const *realData() const { return _re; }
+    double const *imagData() const { return _im; }
+    double const *normData() const { return _norm; }
+
+    void magnitudes(double *out) const;                          // out[i] = |z_i|，批量开方
+    Rank filterByMagnitude(double m1, double m2, Rank *out) const; // 模在[m1,m2)的元素的秩依次写入out，返回个数
+    ComplexVector rangeByMagnitude(double m1, double m2) const;  // 模在[m1,m2)的元素（保持原次序）构成的新向量
+    bool sortedByMagnitude() const { return simdIsSorted(_norm, _size); }
+
+    // 可写访问接口
+    void reserve(Rank c)
+    {
+        if (c > _capacity)
+            reallocate(c);
+    }
+    void push_Back(double re, double im);
+    void clear() { _size = 0; }
+    void sortByMagnitude(); // 按模稳定排序，三列随之一同置换
+
+    template <typename VST>
+    void traverse(VST visit) const // 遍历：visit(实部, 虚部)
+    {
+        for (Rank i = 0; i < _size; i++)
+            visit(_re[i], _im[i]);
+    }
+};
+
+/*
+ * 批量计算内核：AVX2 一次处理4个复数，其余情况走标量循环
+ * 不使用FMA，逐位结果与 re * re + im * im 的标量计算一致
+ */
+
+#if VECTOR_SIMD_X86
+SIMD_TARGET_AVX2 static void avx2ComplexNorms(double const *re, double const *im, double *norm, Rank n)
+{
+    Rank i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = _mm256_loadu_pd(re + i), y = _mm256_loadu_pd(im + i);
+        _mm256_storeu_pd(norm + i, _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+    }
+    for (; i < n; i++)
+        norm[i] = re[i] * re[i] + im[i] * im[i];
+}
+
+SIMD_TARGET_AVX2 static void avx2Sqrt(double const *src, double *dst, Rank n)
+{
+    Rank i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(dst + i, _mm256_sqrt_pd(_mm256_loadu_pd(src + i)));
+    for (; i < n; i++)
+        dst[i] = std::sqrt(src[i]);
+}
+
+SIMD_TARGET_AVX2 static Rank avx2FilterRange(double const *key, Rank n, double lo, double hi, Rank *out)
+{ // 键在[lo,hi)者的秩依次写入out
+    __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    Rank k = 0, i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = _mm256_loadu_pd(key + i);
+        unsigned m = (unsigned)_mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(x, vlo, _CMP_GE_OQ), _mm256_cmp_pd(x, vhi, _CMP_LT_OQ)));
+        for (; m; m &= m - 1) // 逐个取出命中的lane
+            out[k++] = i + __builtin_ctz(m);
+    }
+    for (; i < n; i++)
+        if (key[i] >= lo && key[i] < hi)
+            out[k++] = i;
+    return k;
+}
+#endif
+
+static void complexNorms(double const *re, double const *im, double *norm, Rank n)
+{
+#if VECTOR_SIMD_X86
+    if (simdLevel() == 2)
+        return avx2ComplexNorms(re, im, norm, n);
+#endif
+    for (Rank i = 0; i < n; i++)
+        norm[i] = re[i] * re[i] + im[i] * im[i];
+}
+
+/*---------------------------------------------------------
+ * 函数名称：ComplexVector(double const* re, double const* im, Rank n)
+ * 函数功能：复制实部、虚部两列，再一趟批量算出模平方列
+ */
+inline ComplexVector::ComplexVector(double const *re, double const *im, Rank n)
+    : _size(n), _capacity(n < 1 ? 1 : n)
+{
+    _re = allocColumn(_capacity), _im = allocColumn(_capacity), _norm = allocColumn(_capacity);
+    if (n > 0)
+    {
+        memcpy(_re, re, n * sizeof(double));
+        memcpy(_im, im, n * sizeof(double));
+        complexNorms(_re, _im, _norm, n);
+    }
+}
+
+inline ComplexVector::ComplexVector(ComplexVector const &V)
+    : _size(V._size), _capacity(V._size < 1 ? 1 : V._size)
+{
+    _re = allocColumn(_capacity), _im = allocColumn(_capacity), _norm = allocColumn(_capacity);
+    memcpy(_re, V._re, _size * sizeof(double));
+    memcpy(_im, V._im, _size * sizeof(double));
+    memcpy(_norm, V._norm, _size * sizeof(double));
+}
+
+inline ComplexVector &ComplexVector::operator=(ComplexVector const &V)
+{
+    if (this != &V)
+    {
+        ComplexVector copy(V);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+inline ComplexVector &ComplexVector::operator=(ComplexVector &&V) noexcept
+{
+    if (this != &V)
+    {
+        freeColumn(_re), freeColumn(_im), freeColumn(_norm);
+        _size = V._size, _capacity = V._capacity;
+        _re = V._re, _im = V._im, _norm = V._norm;
+        V._re = V._im = V._norm = nullptr;
+        V._size = V._capacity = 0;
+    }
+    return *this;
+}
+
+inline void ComplexVector::reallocate(Rank c)
+{
+    double *re = allocColumn(c), *im = allocColumn(c), *norm = allocColumn(c);
+    memcpy(re, _re, _size * sizeof(double));
+    memcpy(im, _im, _size * sizeof(double));
+    memcpy(norm, _norm, _size * sizeof(double));
+    freeColumn(_re), freeColumn(_im), freeColumn(_norm);
+    _re = re, _im = im, _norm = norm;
+    _capacity = c;
+}
+
+inline void ComplexVector::push_Back(double re, double im)
+{
+    if (_size == _capacity)
+        reallocate(_capacity < 1 ? 1 : 2 * _capacity); // 容量加倍
+    _re[_size] = re;
+    _im[_size] = im;
+    _norm[_size] = re * re + im * im;
+    _size++;
+}
+
+/*---------------------------------------------------------
+ * 函数名称：magnitudes(double* out) const
+ * 函数功能：批量求模：对模平方列逐个开方（sqrt按IEEE正确舍入，与 std::sqrt 一致）
+ */
+inline void ComplexVector::magnitudes(double *out) const
+{
+#if VECTOR_SIMD_X86
+    if (simdLevel() == 2)
+        return avx2Sqrt(_norm, out, _size);
+#endif
+    for (Rank i = 0; i < _size; i++)
+        out[i] = std::sqrt(_norm[i]);
+}
+
+/*---------------------------------------------------------
+ * 函数名称：filterByMagnitude(double m1, double m2, Rank* out) const
+ * 函数功能：区间查找：把 m1 <= |z| < m2 化为 m1^2 <= norm < m2^2，只扫描模平方一列
+ *          out须能容纳size()个秩
+ */
+inline Rank ComplexVector::filterByMagnitude(double m1, double m2, Rank *out) const
+{
+    if (m1 < 0)
+        m1 = 0;
+    if (m2 <= m1)
+        return 0;
+    double lo = m1 * m1, hi = m2 * m2;
+#if VECTOR_SIMD_X86
+    if (simdLevel() == 2)
+        return avx2FilterRange(_norm, _size, lo, hi, out);
+#endif
+    Rank k = 0;
+    for (Rank i = 0; i < _size; i++)
+        if (_norm[i] >= lo && _norm[i] < hi)
+            out[k++] = i;
+    return k;
+}
+
+inline ComplexVector ComplexVector::rangeByMagnitude(double m1, double m2) const
+{
+    Rank *hit = new Rank[_size > 0 ? _size : 1];
+    Rank k = filterByMagnitude(m1, m2, hit);
+    ComplexVector sub(k);
+    for (Rank j = 0; j < k; j++)
+    { // 三列各自聚集，模平方直接复制不再重算
+        sub._re[j] = _re[hit[j]];
+        sub._im[j] = _im[hit[j]];
+        sub._norm[j] = _norm[hit[j]];
+    }
+    sub._size = k;
+    delete[] hit;
+    return sub;
+}
+
+/*---------------------------------------------------------
+ * 函数名称：sortByMagnitude()
+ * 函数功能：按模排序：只对（模平方，秩）对排序得到置换，再按置换把三列各聚集一次
+ *          模相等时按原秩，排序稳定
+ */
+inline void ComplexVector::sortByMagnitude()
+{
+    if (_size < 2 || sortedByMagnitude())
+        return;
+    Vector<KeyRank<double>> order(_size);
+    for (Rank i = 0; i < _size; i++)
+        order.push_Back(KeyRank<double>{_norm[i], i});
+    order.sort(0); // 默认排序（内省排序）
+    KeyRank<double> const *P = order.data();
+    double *re = allocColumn(_capacity), *im = allocColumn(_capacity), *norm = allocColumn(_capacity);
+    for (Rank i = 0; i < _size; i++)
+    {
+        Rank r = P[i].rank;
+        re[i] = _re[r], im[i] = _im[r], norm[i] = _norm[r];
+    }
+    freeColumn(_re), freeColumn(_im), freeColumn(_norm);
+    _re = re, _im = im, _norm = norm;
+}
+
+#endif
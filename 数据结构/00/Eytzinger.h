@@ -0,0 +1,122 @@
+#ifndef _EYTZINGER_H
+#define _EYTZINGER_H
+
+typedef int Rank; // 秩
+
+/*------------------------------------------------------
+类名称：Eytzinger<T>
+类功能：有序序列的 Eytzinger（层次遍历序）影子布局，供读多写少的有序向量反复查找
+       把有序序列按完全二叉搜索树的层次次序存放：b[k]的孩子为b[2k]、b[2k+1]
+       查找时自根逐层下降，前几层常驻缓存，且每步的孩子位置可提前预取；
+       比较结果直接参与下标计算，无分支
+       建好后与原向量无关联：原向量修改后须重新构造
+*/
+template <typename T>
+class Eytzinger
+{
+    T *_b;       // 层次序存放的元素，b[1, n]（b[0]不用）
+    Rank *_rank; // _rank[k]：b[k]在原有序序列中的秩
+    Rank _n;
+
+    Rank build(T const *A, Rank i, Rank k);                  // 中序遍历以k为根的子树，依次填入A[i...]，返回下一个待填的秩
+    unsigned long long descend(T const &e, bool upper) const; // 自根下降，返回下界（upper时为上界）所在结点
+
+public:
+    Eytzinger(T const *A, Rank n); // 由有序数组A[0,n)构造
+    template <typename V>
+    explicit Eytzinger(V const &sorted); // 由有序向量构造（需 size() 与 operator[]）
+    ~Eytzinger()
+    {
+        delete[] _b;
+        delete[] _rank;
+    }
+
+    Eytzinger(Eytzinger const &) = delete;
+    Eytzinger &operator=(Eytzinger const &) = delete;
+
+    Rank size() const { return _n; }
+    Rank lowerBound(T const &e) const; // 原序列中首个不小于e的秩，无则为size()
+    Rank upperBound(T const &e) const; // 原序列中首个大于e的秩，无则为size()
+    Rank search(T const &e) const;     // 命中时返回首个等于e的秩，否则返回-1
+};
+
+template <typename T>
+Eytzinger<T>::Eytzinger(T const *A, Rank n) : _b(new T[n + 1]), _rank(new Rank[n + 1]), _n(n)
+{
+    build(A, 0, 1);
+}
+
+template <typename T>
+template <typename V>
+Eytzinger<T>::Eytzinger(V const &sorted) : _b(new T[sorted.size() + 1]), _rank(new Rank[sorted.size() + 1]), _n(sorted.size())
+{
+    T *A = new T[_n > 0 ? _n : 1];
+    for (Rank i = 0; i < _n; i++)
+        A[i] = sorted[i];
+    build(A, 0, 1);
+    delete[] A;
+}
+
+template <typename T>
+Rank Eytzinger<T>::build(T const *A, Rank i, Rank k)
+{
+    if (k <= _n)
+    {
+        i = build(A, i, 2 * k); // 左子树
+        _b[k] = A[i];
+        _rank[k] = i++;
+        i = build(A, i, 2 * k + 1); // 右子树
+    }
+    return i;
+}
+
+/*------------------------------------------------------
+函数名称：descend(T const& e, bool upper)
+函数功能：自根下降，k = 2k + (b[k] < e)（upper时为 b[k] <= e）；落到树外后，
+         k 的二进制末尾连续的1对应最后几次向右，去掉它们及其上一位即得答案所在结点
+         返回结点编号，0表示答案在末尾之后
+*/
+template <typename T>
+unsigned long long Eytzinger<T>::descend(T const &e, bool upper) const
+{
+    unsigned long long k = 1;
+    while (k <= (unsigned long long)_n)
+    {
+#if defined(__GNUC__)
+        if (16 * k <= (unsigned long long)_n) // 只预取树内的结点，不构造越界指针
+            __builtin_prefetch(_b + 16 * k);    // 预取四层之后的后代
+#endif
+        k = 2 * k + (upper ? !(e < _b[k]) : (_b[k] < e));
+    }
+#if defined(__GNUC__)
+    k >>= __builtin_ffsll((long long)~k);
+#else
+    while (k & 1)
+        k >>= 1;
+    k >>= 1;
+#endif
+    return k;
+}
+
+template <typename T>
+Rank Eytzinger<T>::lowerBound(T const &e) const
+{
+    unsigned long long k = descend(e, false);
+    return k ? _rank[k] : _n;
+}
+
+template <typename T>
+Rank Eytzinger<T>::upperBound(T const &e) const
+{
+    unsigned long long k = descend(e, true);
+    return k ? _rank[k] : _n;
+}
+
+template <typename T>
+Rank Eytzinger<T>::search(T const &e) const
+{
+    unsigned long long k = descend(e, false);
+    return (k && !(e < _b[k])) ? _rank[k] : -1;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef _PARALLEL_H
+#define _PARALLEL_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*------------------------------------------------------
+函数名称：hardwareThreads()
+函数功能：可用的硬件线程数（至少为1）
+*/
+static int hardwareThreads()
+{
+    int p = (int)std::thread::hardware_concurrency();
+    return p < 1 ? 1 : p;
+}
+
+/*------------------------------------------------------
+结构名称：ThreadJoiner
+结构功能：析构时合并（join）全部已启动的线程
+         开线程失败或调用者线程中的任务抛出异常时，异常向外传播之前先等已启动者结束，
+         不会析构仍可合并的 std::thread（那会调用 std::terminate）
+*/
+struct ThreadJoiner
+{
+    std::vector<std::thread> &threads;
+
+    ~ThreadJoiner()
+    {
+        for (std::thread &t : threads)
+            if (t.joinable())
+                t.join();
+    }
+};
+
+/*------------------------------------------------------
+函数名称：parallelFor(int p, F f)
+函数功能：以p个线程并行执行 f(0), f(1), ..., f(p-1)，全部完成后返回
+         f(0)在调用者线程中执行，其余各开一个线程
+*/
+template <typename F>
+static void parallelFor(int p, F f)
+{
+    if (p <= 1)
+    {
+        f(0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(p - 1);
+    ThreadJoiner joiner{workers};
+    for (int t = 1; t < p; t++)
+        workers.emplace_back(f, t);
+    f(0);
+}
+
+/*------------------------------------------------------
+函数名称：parallelInvoke(F1 f1, F2 f2)
+函数功能：f1另开线程、f2在当前线程并行执行，二者完成后返回（fork-join）
+         没有线程池：每次调用都新开一个线程，递归调用时须自行限制分叉深度
+         （parallelMergeSort 每层线程数减半，深度不超过 log2(PARALLEL_MAX_THREADS)）
+*/
+template <typename F1, typename F2>
+static void parallelInvoke(F1 f1, F2 f2)
+{
+    std::vector<std::thread> worker;
+    ThreadJoiner joiner{worker};
+    worker.emplace_back(f1);
+    f2();
+}
+
+/*------------------------------------------------------
+枚举名称：Schedule
+枚举功能：区间划分给各线程的方式
+         STATIC_SCHEDULE  静态：均分为p段，每线程一段，开销最小，适合每个元素代价相同的情形
+         DYNAMIC_SCHEDULE 动态：切成grain大小的块，各线程做完一块再领下一块，适合代价不均的情形
+*/
+enum Schedule
+{
+    STATIC_SCHEDULE,
+    DYNAMIC_SCHEDULE
+};
+
+/*------------------------------------------------------
+函数名称：chunkCount(long long n, int p, Schedule s, long long grain)
+函数功能：按 parallelChunks 的划分方式，[0,n)被切成的块数
+*/
+static long long chunkCount(long long n, int p, Schedule s, long long grain)
+{
+    if (s == STATIC_SCHEDULE)
+        return p;
+    if (grain < 1)
+        grain = 1;
+    return (n + grain - 1) / grain;
+}
+
+/*------------------------------------------------------
+函数名称：parallelChunks(long long n, int p, Schedule s, long long grain, F f)
+函数功能：把[0,n)切块后以p个线程并行执行 f(c, lo, hi)：c为块号，[lo,hi)为该块的区间
+         块号与区间的对应只取决于n、p、s、grain，与线程的执行快慢无关
+*/
+template <typename F>
+static void parallelChunks(long long n, int p, Schedule s, long long grain, F f)
+{
+    if (s == STATIC_SCHEDULE)
+    {
+        parallelFor(p, [&](int t) { f(t, n * t / p, n * (t + 1) / p); });
+        return;
+    }
+    if (grain < 1)
+        grain = 1;
+    long long chunks = (n + grain - 1) / grain;
+    std::atomic<long long> next(0); // 下一个待领取的块
+    parallelFor(p, [&](int) {
+        for (long long c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;)
+            f(c, c * grain, c + 1 < chunks ? (c + 1) * grain : n);
+    });
+}
+
+#endif
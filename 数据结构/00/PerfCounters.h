@@ -0,0 +1,334 @@
+#ifndef _PERF_COUNTERS_H
+#define _PERF_COUNTERS_H
+
+/*
+ * Vector 操作的性能计数（可选，默认关闭）
+ * 编译时定义 VECTOR_PERF=1 开启，例：g++ -DVECTOR_PERF=1 ...；关闭时以下各宏、PerfTally 均为空操作，不产生任何代码
+ * 开启后，每次 sort/stableSort/deduplicate/uniquify/expand/shrink 调用按操作名累计：
+ *   硬件计数：周期、指令、缓存未命中、分支预测失败（Linux perf_event_open，只计用户态；
+ *            不可用时（非Linux、无PMU的虚拟机、perf_event_paranoid 过高）只记软件计数，hw为false）
+ *   软件计数：元素比较、元素搬移、空间申请（扩容/缩容/排序缓冲区）
+ *            各排序内核（冒泡、插入、切分与取中、堆下滤、归并、基数分发、并行归并与样本排序的分桶）
+ *            以及去重、唯一化中的比较与搬移均计入；一次交换记三次搬移
+ * 计数为包含式：操作内嵌套的操作（如 deduplicate 中的 shrink）同时计入两者
+ * 软件计数为进程内全局量，其他线程同时进行的 Vector 操作也会计入
+ */
+
+#ifndef VECTOR_PERF
+#define VECTOR_PERF 0
+#endif
+
+#if VECTOR_PERF
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+/*------------------------------------------------------
+结构名称：PerfSample
+结构功能：一组计数值；hw为false时硬件计数无效（均为0）
+*/
+struct PerfSample
+{
+    bool hw = false;
+    unsigned long long cycles = 0, instructions = 0, cacheMisses = 0, branchMisses = 0; // 硬件计数
+    unsigned long long comparisons = 0, moves = 0, allocations = 0;                    // 软件计数
+    unsigned long long ns = 0;                                                         // 耗时（纳秒）
+
+    PerfSample &operator+=(PerfSample const &o)
+    {
+        hw = hw || o.hw;
+        cycles += o.cycles, instructions += o.instructions, cacheMisses += o.cacheMisses, branchMisses += o.branchMisses;
+        comparisons += o.comparisons, moves += o.moves, allocations += o.allocations;
+        ns += o.ns;
+        return *this;
+    }
+};
+
+#if VECTOR_PERF
+
+/*------------------------------------------------------
+结构名称：PerfSoftware
+结构功能：软件计数的全局累加器；热循环中先记在局部的 PerfTally 里，操作结束时才加到这里
+*/
+struct PerfSoftware
+{
+    static std::atomic<unsigned long long> &comparisons()
+    {
+        static std::atomic<unsigned long long> c(0);
+        return c;
+    }
+    static std::atomic<unsigned long long> &moves()
+    {
+        static std::atomic<unsigned long long> c(0);
+        return c;
+    }
+    static std::atomic<unsigned long long> &allocations()
+    {
+        static std::atomic<unsigned long long> c(0);
+        return c;
+    }
+};
+
+/*------------------------------------------------------
+结构名称：PerfTally
+结构功能：函数内的局部软件计数，析构时一次性累加到全局计数
+         less(a, b)、equal(a, b) 比较并计数；compare(n) 记未经两者的比较次数；move(n)、allocate(n) 记搬移、申请次数
+*/
+struct PerfTally
+{
+    unsigned long long cmp = 0, mov = 0, alloc = 0;
+
+    template <typename A, typename B>
+    bool less(A const &a, B const &b)
+    {
+        cmp++;
+        return a < b;
+    }
+    template <typename A, typename B>
+    bool equal(A const &a, B const &b)
+    {
+        cmp++;
+        return a == b;
+    }
+    void compare(long long n) { cmp += (unsigned long long)n; }
+    void move(long long n) { mov += (unsigned long long)n; }
+    void allocate(long long n = 1) { alloc += (unsigned long long)n; }
+    ~PerfTally()
+    {
+        if (cmp)
+            PerfSoftware::comparisons().fetch_add(cmp, std::memory_order_relaxed);
+        if (mov)
+            PerfSoftware::moves().fetch_add(mov, std::memory_order_relaxed);
+        if (alloc)
+            PerfSoftware::allocations().fetch_add(alloc, std::memory_order_relaxed);
+    }
+};
+
+/*------------------------------------------------------
+类名称：PerfCounters
+类功能：当前线程的四个硬件计数器（周期、指令、缓存未命中、分支预测失败）
+       打开后一直运行，读数之差即区间内的计数；inherit 使其后创建的线程（并行排序的工作线程）
+       结束时计数并入本线程，故并行操作的计数包括全部工作线程
+       每个计数器单独打开（带 inherit 的计数器不能成组读取），任一打开失败则硬件计数整体不可用
+*/
+class PerfCounters
+{
+    int _fd[4];
+    bool _ok;
+
+#if defined(__linux__)
+    static int open(unsigned type, unsigned long long config)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1; // 只计用户态，perf_event_paranoid 为2时也可用
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0); // 本线程，任意CPU
+    }
+#endif
+
+public:
+    PerfCounters() : _ok(false)
+    {
+        for (int i = 0; i < 4; i++)
+            _fd[i] = -1;
+#if defined(__linux__)
+        static const unsigned long long configs[4] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        _ok = true;
+        for (int i = 0; i < 4 && _ok; i++)
+            _ok = (_fd[i] = open(PERF_TYPE_HARDWARE, configs[i])) >= 0;
+#endif
+    }
+    ~PerfCounters()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < 4; i++)
+            if (_fd[i] >= 0)
+                close(_fd[i]);
+#endif
+    }
+    PerfCounters(PerfCounters const &) = delete;
+    PerfCounters &operator=(PerfCounters const &) = delete;
+
+    bool available() const { return _ok; }
+
+    PerfSample read() const // 当前读数（硬件、软件计数均为累计值）
+    {
+        PerfSample s;
+#if defined(__linux__)
+        if (_ok)
+        {
+            unsigned long long v[4] = {0, 0, 0, 0};
+            bool ok = true;
+            for (int i = 0; i < 4; i++)
+                ok = ok && ::read(_fd[i], &v[i], sizeof(v[i])) == (ssize_t)sizeof(v[i]);
+            if (ok)
+                s.hw = true, s.cycles = v[0], s.instructions = v[1], s.cacheMisses = v[2], s.branchMisses = v[3];
+        }
+#endif
+        s.comparisons = PerfSoftware::comparisons().load(std::memory_order_relaxed);
+        s.moves = PerfSoftware::moves().load(std::memory_order_relaxed);
+        s.allocations = PerfSoftware::allocations().load(std::memory_order_relaxed);
+        s.ns = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+        return s;
+    }
+
+    static PerfCounters &local() // 当前线程的计数器，首次使用时打开
+    {
+        static thread_local PerfCounters counters;
+        return counters;
+    }
+};
+
+/*------------------------------------------------------
+类名称：PerfRegistry
+类功能：按操作名累计的计数表（调用次数 + 各计数之和），线程安全
+       操作名须为字符串字面量（按指针保存）
+*/
+class PerfRegistry
+{
+public:
+    struct Entry
+    {
+        char const *op;
+        unsigned long long calls;
+        PerfSample total;
+    };
+
+private:
+    static const int MAX_OPS = 32;
+    Entry _entries[MAX_OPS];
+    int _count = 0;
+    mutable std::mutex _mutex;
+
+public:
+    static PerfRegistry &instance()
+    {
+        static PerfRegistry registry;
+        return registry;
+    }
+
+    void add(char const *op, PerfSample const &delta)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        int i = 0;
+        while (i < _count && strcmp(_entries[i].op, op))
+            i++;
+        if (i == _count)
+        {
+            if (_count == MAX_OPS)
+                return; // 表满，忽略新操作
+            _entries[_count++] = Entry{op, 0, PerfSample()};
+        }
+        _entries[i].calls++;
+        _entries[i].total += delta;
+    }
+
+    Entry get(char const *op) const // 未记录过的操作返回全0
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (int i = 0; i < _count; i++)
+            if (!strcmp(_entries[i].op, op))
+                return _entries[i];
+        return Entry{op, 0, PerfSample()};
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _count = 0;
+    }
+
+    void report(std::ostream &os) const // 每个操作一行：调用次数、总计数，以及每次调用的平均周期数
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        char line[256];
+        snprintf(line, sizeof(line), "%-12s %8s %12s %14s %14s %12s %12s %14s %14s %10s\n", "op", "calls", "ms",
+                 "cycles", "instructions", "cache-miss", "branch-miss", "comparisons", "moves", "allocs");
+        os << line;
+        for (int i = 0; i < _count; i++)
+        {
+            Entry const &e = _entries[i];
+            PerfSample const &s = e.total;
+            if (s.hw)
+                snprintf(line, sizeof(line), "%-12s %8llu %12.3f %14llu %14llu %12llu %12llu %14llu %14llu %10llu\n", e.op,
+                         e.calls, s.ns / 1e6, s.cycles, s.instructions, s.cacheMisses, s.branchMisses, s.comparisons,
+                         s.moves, s.allocations);
+            else
+                snprintf(line, sizeof(line), "%-12s %8llu %12.3f %14s %14s %12s %12s %14llu %14llu %10llu\n", e.op, e.calls,
+                         s.ns / 1e6, "-", "-", "-", "-", s.comparisons, s.moves, s.allocations);
+            os << line;
+        }
+    }
+};
+
+/*------------------------------------------------------
+类名称：PerfScope
+类功能：作用域计数：构造时读一次，析构时再读一次，差值记入 PerfRegistry 中的操作名下
+*/
+class PerfScope
+{
+    char const *_op;
+    PerfSample _start;
+
+public:
+    explicit PerfScope(char const *op) : _op(op), _start(PerfCounters::local().read()) {}
+    ~PerfScope()
+    {
+        PerfSample end = PerfCounters::local().read(), d;
+        d.hw = _start.hw && end.hw;
+        if (d.hw)
+        {
+            d.cycles = end.cycles - _start.cycles, d.instructions = end.instructions - _start.instructions;
+            d.cacheMisses = end.cacheMisses - _start.cacheMisses, d.branchMisses = end.branchMisses - _start.branchMisses;
+        }
+        d.comparisons = end.comparisons - _start.comparisons;
+        d.moves = end.moves - _start.moves;
+        d.allocations = end.allocations - _start.allocations;
+        d.ns = end.ns - _start.ns;
+        PerfRegistry::instance().add(_op, d);
+    }
+    PerfScope(PerfScope const &) = delete;
+    PerfScope &operator=(PerfScope const &) = delete;
+};
+
+#define VECTOR_PERF_CONCAT2(a, b) a##b
+#define VECTOR_PERF_CONCAT(a, b) VECTOR_PERF_CONCAT2(a, b)
+#define VECTOR_PERF_SCOPE(op) PerfScope VECTOR_PERF_CONCAT(_perfScope, __LINE__)(op) // 本作用域计入操作op
+
+#else // !VECTOR_PERF
+
+struct PerfTally // 空操作
+{
+    template <typename A, typename B>
+    bool less(A const &a, B const &b) { return a < b; }
+    template <typename A, typename B>
+    bool equal(A const &a, B const &b) { return a == b; }
+    void compare(long long) {}
+    void move(long long) {}
+    void allocate(long long = 1) {}
+};
+
+#define VECTOR_PERF_SCOPE(op) ((void)0)
+
+#endif
+
+#endif
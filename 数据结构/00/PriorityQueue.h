@@ -0,0 +1,291 @@
+#ifndef _PRIORITY_QUEUE_H
+#define _PRIORITY_QUEUE_H
+
+#include <stdexcept>
+
+#include "Vector.cpp"
+
+/*
+ * 带索引的优先级队列：元素为编号 0..n-1，各带一个键（按 operator< 比较，小者优先）
+ * 每个编号同时至多在队列中出现一次，可按编号查询、减小其键，
+ * 故 Dijkstra/Prim 中距离变小时直接调整，不必像惰性删除那样压入重复项
+ * IndexedHeap 与 PairingHeap 接口相同，可互换：
+ *   push(id, k)        id入队，键为k（id须不在队列中）
+ *   decreaseKey(id, k) 把队列中id的键减小为k（k不大于原键）
+ *   contains(id)、key(id)、top()、topKey()、pop()、size()、empty()
+ * VECTOR_CHECKED 为1时，违反上述前提或对空队列 top()/pop() 抛出异常
+ */
+
+/*------------------------------------------------------
+类名称：IndexedHeap<K, D>
+类功能：带索引的D叉堆（默认4叉），以向量存放
+       _heap 按堆序存放（键，编号），_pos[id] 为编号id在 _heap 中的位置（-1表示不在队列中）
+       结点i的孩子为 D*i+1 .. D*i+D：4叉时四个孩子的（键，编号）相邻存放，下滤时一次取齐；
+       树高为二叉堆的一半，decreaseKey（上滤）的比较次数随之减半
+*/
+template <typename K, int D = 4>
+class IndexedHeap
+{
+    struct Entry
+    {
+        K key;
+        Rank id;
+    };
+    Vector<Entry> _heap;
+    Vector<Rank> _pos;
+
+    void place(Rank i, Entry const &e) // 把e放在位置i，并更新其位置索引
+    {
+        _heap.at_unchecked(i) = e;
+        _pos.at_unchecked(e.id) = i;
+    }
+    void percolateUp(Rank i);   // 自i上滤
+    void percolateDown(Rank i); // 自i下滤
+
+public:
+    explicit IndexedHeap(Rank n) : _heap(n < 1 ? 1 : n), _pos(n, n, -1) // 编号范围 [0,n)
+    {
+        _heap.setPolicy(CapacityPolicy::neverShrink());
+    }
+
+    Rank size() const { return _heap.size(); }
+    bool empty() const { return _heap.empty(); }
+    bool contains(Rank id) const { return _pos[id] >= 0; }
+    K const &key(Rank id) const { return _heap[_pos[id]].key; } // 队列中id的键
+    Rank top() const { return _heap[0].id; }                    // 键最小者的编号
+    K const &topKey() const { return _heap[0].key; }
+
+    void push(Rank id, K const &k);
+    void decreaseKey(Rank id, K const &k);
+    Rank pop(); // 删除键最小者，返回其编号
+};
+
+template <typename K, int D>
+void IndexedHeap<K, D>::percolateUp(Rank i)
+{
+    Entry e = _heap.at_unchecked(i);
+    while (i > 0)
+    {
+        Rank p = (i - 1) / D;
+        if (!(e.key < _heap.at_unchecked(p).key))
+            break;
+        place(i, _heap.at_unchecked(p));
+        i = p;
+    }
+    place(i, e);
+}
+
+template <typename K, int D>
+void IndexedHeap<K, D>::percolateDown(Rank i)
+{
+    Rank n = _heap.size();
+    Entry e = _heap.at_unchecked(i);
+    for (;;)
+    {
+        Rank c = D * i + 1; // 首个孩子
+        if (c >= n)
+            break;
+        Rank end = c + D < n ? c + D : n, m = c; // m：孩子中键最小者
+        for (Rank j = c + 1; j < end; j++)
+            if (_heap.at_unchecked(j).key < _heap.at_unchecked(m).key)
+                m = j;
+        if (!(_heap.at_unchecked(m).key < e.key))
+            break;
+        place(i, _heap.at_unchecked(m));
+        i = m;
+    }
+    place(i, e);
+}
+
+template <typename K, int D>
+void IndexedHeap<K, D>::push(Rank id, K const &k)
+{
+#if VECTOR_CHECKED
+    if (contains(id))
+        throw std::invalid_argument("IndexedHeap::push: id already queued");
+#endif
+    _heap.push_Back(Entry{k, id});
+    percolateUp(_heap.size() - 1);
+}
+
+template <typename K, int D>
+void IndexedHeap<K, D>::decreaseKey(Rank id, K const &k)
+{
+#if VECTOR_CHECKED
+    if (!contains(id) || key(id) < k)
+        throw std::invalid_argument("IndexedHeap::decreaseKey: id not queued or key increased");
+#endif
+    Rank i = _pos.at_unchecked(id);
+    _heap.at_unchecked(i).key = k;
+    percolateUp(i);
+}
+
+template <typename K, int D>
+Rank IndexedHeap<K, D>::pop()
+{
+#if VECTOR_CHECKED
+    if (empty())
+        throw std::out_of_range("IndexedHeap::pop: empty");
+#endif
+    Rank id = _heap.at_unchecked(0).id;
+    _pos.at_unchecked(id) = -1;
+    Entry last = _heap.remove(_heap.size() - 1);
+    if (!_heap.empty())
+    { // 末项移至堆顶，下滤
+        _heap.at_unchecked(0) = last;
+        percolateDown(0);
+    }
+    return id;
+}
+
+template <typename K>
+using QuaternaryHeap = IndexedHeap<K, 4>; // 4叉堆，供需要单参数模板之处（如 Graph::dijkstra<QuaternaryHeap>）
+
+/*------------------------------------------------------
+类名称：PairingHeap<K>
+类功能：带索引的配对堆；结点按编号预先分配在向量中，以秩代替指针
+       各结点的孩子构成一个单链表：child 指向首个孩子，sibling 指向右兄弟，
+       prev 指向左兄弟（首个孩子的 prev 指向父亲），故可O(1)从树中剪下任一结点
+       push、decreaseKey 为O(1)（把新树与根比较后链接）；pop 均摊O(logn)（孩子两趟配对合并）
+*/
+template <typename K>
+class PairingHeap
+{
+    struct Node
+    {
+        K key;
+        Rank child, sibling, prev;
+        bool queued;
+    };
+    Vector<Node> _node;
+    Vector<Rank> _pairs; // pop 时暂存配对结果，反复使用
+    Rank _root, _size;
+
+    Rank link(Rank a, Rank b); // 合并两棵树（a、b均为根），返回新根
+    void cut(Rank x);          // 把x（非根）连同其子树从父亲的孩子链表中剪下
+
+public:
+    explicit PairingHeap(Rank n) : _node(n, n, Node{K(), -1, -1, -1, false}), _root(-1), _size(0) // 编号范围 [0,n)
+    {
+        _pairs.setPolicy(CapacityPolicy::neverShrink());
+    }
+
+    Rank size() const { return _size; }
+    bool empty() const { return !_size; }
+    bool contains(Rank id) const { return _node[id].queued; }
+    K const &key(Rank id) const { return _node[id].key; }
+    Rank top() const;
+    K const &topKey() const { return _node[top()].key; }
+
+    void push(Rank id, K const &k);
+    void decreaseKey(Rank id, K const &k);
+    Rank pop();
+};
+
+template <typename K>
+Rank PairingHeap<K>::link(Rank a, Rank b)
+{
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (_node.at_unchecked(b).key < _node.at_unchecked(a).key)
+        std::swap(a, b); // 键相等时保留a为根
+    Node &na = _node.at_unchecked(a), &nb = _node.at_unchecked(b);
+    nb.sibling = na.child; // b成为a的首个孩子
+    if (na.child >= 0)
+        _node.at_unchecked(na.child).prev = b;
+    nb.prev = a;
+    na.child = b;
+    na.sibling = na.prev = -1;
+    return a;
+}
+
+template <typename K>
+void PairingHeap<K>::cut(Rank x)
+{
+    Node &nx = _node.at_unchecked(x);
+    Node &np = _node.at_unchecked(nx.prev);
+    if (np.child == x)
+        np.child = nx.sibling; // x为首个孩子，prev是父亲
+    else
+        np.sibling = nx.sibling;
+    if (nx.sibling >= 0)
+        _node.at_unchecked(nx.sibling).prev = nx.prev;
+    nx.sibling = nx.prev = -1;
+}
+
+template <typename K>
+Rank PairingHeap<K>::top() const
+{
+#if VECTOR_CHECKED
+    if (empty())
+        throw std::out_of_range("PairingHeap::top: empty");
+#endif
+    return _root;
+}
+
+template <typename K>
+void PairingHeap<K>::push(Rank id, K const &k)
+{
+#if VECTOR_CHECKED
+    if (contains(id))
+        throw std::invalid_argument("PairingHeap::push: id already queued");
+#endif
+    Node &n = _node[id];
+    n.key = k;
+    n.child = n.sibling = n.prev = -1;
+    n.queued = true;
+    _root = link(_root, id);
+    _size++;
+}
+
+template <typename K>
+void PairingHeap<K>::decreaseKey(Rank id, K const &k)
+{
+#if VECTOR_CHECKED
+    if (!contains(id) || key(id) < k)
+        throw std::invalid_argument("PairingHeap::decreaseKey: id not queued or key increased");
+#endif
+    _node.at_unchecked(id).key = k;
+    if (id == _root)
+        return;
+    cut(id); // 连同子树剪下，再与根链接（子树内的堆序不受影响）
+    _root = link(_root, id);
+}
+
+/*---------------------------------------------------------
+ * 函数名称：pop()
+ * 函数功能：删除根，其孩子两趟合并：自左向右两两链接，再自右向左逐个并入
+ */
+template <typename K>
+Rank PairingHeap<K>::pop()
+{
+#if VECTOR_CHECKED
+    if (empty())
+        throw std::out_of_range("PairingHeap::pop: empty");
+#endif
+    Rank id = _root;
+    Node &root = _node.at_unchecked(id);
+    Rank c = root.child;
+    root.child = -1;
+    root.queued = false;
+    _pairs.clear();
+    while (c >= 0)
+    { // 第一趟：两两链接
+        Rank a = c, b = _node.at_unchecked(a).sibling;
+        c = b >= 0 ? _node.at_unchecked(b).sibling : -1;
+        _node.at_unchecked(a).sibling = _node.at_unchecked(a).prev = -1;
+        if (b >= 0)
+            _node.at_unchecked(b).sibling = _node.at_unchecked(b).prev = -1;
+        _pairs.push_Back(link(a, b));
+    }
+    Rank r = -1;
+    for (Rank i = _pairs.size() - 1; i >= 0; i--) // 第二趟：自右向左合并
+        r = link(_pairs.at_unchecked(i), r);
+    _root = r;
+    _size--;
+    return id;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef _RANDOM_H
+#define _RANDOM_H
+
+#include <atomic>
+#include <cstdint>
+
+/*------------------------------------------------------
+函数名称：splitMix64(uint64_t& x)
+函数功能：SplitMix64：推进状态x并输出一个64位数，用于把任意种子展开为生成器的初始状态
+*/
+static inline uint64_t splitMix64(uint64_t &x)
+{
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/*------------------------------------------------------
+类名称：Xoshiro256
+类功能：xoshiro256** 伪随机数生成器：256位状态，周期 2^256 - 1，每次输出64位
+       同一种子（及流号）总是产生同一序列，可复现；
+       不同流号的生成器相互独立，供并行任务各用一条流
+       满足 UniformRandomBitGenerator，可直接交给 std:: 分布与算法
+       非线程安全：每个线程用自己的生成器（如 local()）
+*/
+class Xoshiro256
+{
+    uint64_t _s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef uint64_t result_type;
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return ~uint64_t(0); }
+
+    explicit Xoshiro256(uint64_t seed = 0x5eed, uint64_t stream = 0) { this->seed(seed, stream); }
+
+    void seed(uint64_t seed, uint64_t stream = 0) // 由（种子，流号）确定初始状态
+    {
+        uint64_t x = seed;
+        x = splitMix64(x) ^ (stream * 0xd1342543de82ef95ull); // 同一种子下不同流号得到不同的起点
+        for (int i = 0; i < 4; i++)
+            _s[i] = splitMix64(x); // SplitMix64 的输出不会全为0
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(_s[1] * 5, 7) * 9;
+        uint64_t t = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return result;
+    }
+    uint64_t operator()() { return next(); }
+
+    uint64_t bounded(uint64_t n);                        // [0,n)中的均匀随机整数（无偏），n > 0
+    int64_t range(int64_t lo, int64_t hi) { return lo + (int64_t)bounded((uint64_t)(hi - lo)); } // [lo,hi)中的均匀随机整数
+    double nextDouble() { return (next() >> 11) * 0x1.0p-53; } // [0,1)中的均匀随机实数，53位精度
+
+    static Xoshiro256 &local(); // 当前线程的生成器（各线程以固定种子、不同流号初始化）
+};
+
+/*------------------------------------------------------
+函数名称：bounded(uint64_t n)
+函数功能：Lemire 的乘法取高位法：64位随机数x乘以n取高64位即落在[0,n)，
+         仅当低64位落入 2^64 mod n 以下的偏差区时重抽，结果严格均匀；
+         绝大多数情况下无需除法（取模只在可能重抽时才计算一次）
+*/
+inline uint64_t Xoshiro256::bounded(uint64_t n)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 m = (unsigned __int128)next() * n;
+    uint64_t low = (uint64_t)m;
+    if (low < n)
+    {
+        uint64_t threshold = (0 - n) % n; // 2^64 mod n
+        while (low < threshold)
+        {
+            m = (unsigned __int128)next() * n;
+            low = (uint64_t)m;
+        }
+    }
+    return (uint64_t)(m >> 64);
+#else
+    uint64_t threshold = (0 - n) % n; // 拒绝最低的 2^64 mod n 个值，其余值对n取模均匀
+    for (;;)
+    {
+        uint64_t x = next();
+        if (x >= threshold)
+            return x % n;
+    }
+#endif
+}
+
+inline Xoshiro256 &Xoshiro256::local()
+{
+    static std::atomic<uint64_t> streams(0); // 已分配的流号
+    static thread_local Xoshiro256 rng(0x5eed, streams.fetch_add(1, std::memory_order_relaxed));
+    return rng;
+}
+
+#endif
@@ -1,24 +1,218 @@
 #ifndef _VECTOR_H
 #define _VECTOR_H
 
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Allocator.h"
+#include "Eytzinger.h"
+#include "Parallel.h"
+#include "PerfCounters.h"
+#include "Random.h"
+#include "VectorSimd.h"
+
 using namespace std;
 
 typedef int Rank;          // 秩
 #define DEFAULT_CAPACITY 3 // 默认初始容量
+#define INSERTION_CUTOFF 16 // 小于该规模的区间改用插入排序
+#define NINTHER_CUTOFF 128  // 大于该规模的区间用九数取中(ninther)选轴点
+#define PARALLEL_CUTOFF (1 << 14)   // 小于该规模的区间不再并行
+#define PARALLEL_GRAIN (1 << 16)    // 动态调度时每次领取的元素数
+#define PARALLEL_MAX_THREADS 64     // 并行排序至多使用的线程数（并行归并排序的分叉深度至多为其log2）
+#define SAMPLESORT_CUTOFF (1 << 22) // 不小于该规模的区间并行排序改用样本排序
+#define SAMPLESORT_OVERSAMPLE 64    // 样本排序每个桶的过采样数
+#define RADIX_CUTOFF 256            // 小于该规模的区间默认排序不用基数排序
+#define MIN_RUN 32                  // 自然归并排序中，短于该长度的顺序段以插入排序补足
+#define MIN_GALLOP 7                // 合并时一侧连胜该次数后转入跳跃（galloping）模式
+#define BATCH_LANES 8               // 批量查找时同步推进的查找路数
+#define SHUFFLE_BLOCK (1 << 16)     // 并行置乱时每块（每条随机流）负责的元素数
+#define SHUFFLE_BUCKETS 1024        // 并行置乱的桶数上限
+
+// operator[] 是否检查越界：未定义时调试版本（未定义NDEBUG）检查，发布版本不检查
+#ifndef VECTOR_CHECKED
+#ifdef NDEBUG
+#define VECTOR_CHECKED 0
+#else
+#define VECTOR_CHECKED 1
+#endif
+#endif
 
-// #define Vector iyan_vector
+/*------------------------------------------------------
+类名称：VectorView<T>
+类功能：向量中一段连续区间的只读视图（不拥有元素，不复制）
+       仅在原向量未被修改（插入、删除、扩容、缩容）期间有效
+*/
+template <typename T>
+class VectorView
+{
+    T *_begin, *_end;
+
+public:
+    VectorView(T *b = nullptr, T *e = nullptr) : _begin(b), _end(e) {}
+
+    Rank size() const { return (Rank)(_end - _begin); }
+    bool empty() const { return _begin == _end; }
+    T &operator[](Rank r) const { return _begin[r]; }
+    T *begin() const { return _begin; }
+    T *end() const { return _end; }
+
+    template <typename VST>
+    void traverse(VST visit) const // 遍历区间中的元素
+    {
+        for (T *p = _begin; p < _end; p++)
+            visit(*p);
+    }
+};
+
+/*------------------------------------------------------
+结构名称：CapacityPolicy
+结构功能：向量的扩容/缩容策略
+         growth：   扩容倍数（>1），满载时容量乘以该倍数；不大于1（或非数）时取2，大于 MAX_GROWTH 时取 MAX_GROWTH
+         shrinkRatio：装填因子降到 1/shrinkRatio 以下时，容量除以growth；0表示从不缩容
+         须 shrinkRatio > growth：缩容后装填因子仍低于1，插入删除在阈值附近交替时不会反复重新分配
+*/
+struct CapacityPolicy
+{
+    static constexpr double MAX_GROWTH = 16.0; // 扩容倍数上限
+
+    double growth;
+    int shrinkRatio;
+
+    CapacityPolicy(double g = 2.0, int r = 4) : growth(g > 1.0 ? (g < MAX_GROWTH ? g : MAX_GROWTH) : 2.0), shrinkRatio(r)
+    {
+        if (shrinkRatio && shrinkRatio <= growth)
+            shrinkRatio = (int)growth + 1; // 保证滞回区间
+    }
+    static CapacityPolicy neverShrink(double g = 2.0) { return CapacityPolicy(g, 0); } // 从不缩容
+};
+
+/*------------------------------------------------------
+结构名称：CapacityStats
+结构功能：重新分配计数，用于核实容量策略的效果
+*/
+struct CapacityStats
+{
+    long long reallocs = 0; // 重新分配空间的总次数
+    long long expands = 0;  // 其中扩容次数
+    long long shrinks = 0;  // 其中缩容次数
+};
+
+/*------------------------------------------------------
+结构名称：IsStdHashable<T>
+结构功能：T 是否可用 std::hash<T> 散列
+*/
+template <typename T, typename = void>
+struct IsStdHashable : std::false_type
+{
+};
+
+template <typename T>
+struct IsStdHashable<T, decltype(void(std::hash<T>()(std::declval<T const &>())))> : std::true_type
+{
+};
+
+/*------------------------------------------------------
+函数名称：hashMix(size_t h)
+函数功能：打散散列值的各位（MurmurHash3 的 fmix64），
+         std::hash 对整数常为恒等映射，直接取低位作槽号会大量冲突
+*/
+static inline size_t hashMix(size_t h)
+{
+    unsigned long long x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+/*------------------------------------------------------
+结构名称：KeyRank<K>
+结构功能：sortByKey 使用的（键，秩）对，紧凑存放；键相等时按秩比较，排序结果即稳定
+*/
+template <typename K>
+struct KeyRank
+{
+    K key;
+    Rank rank;
+    bool operator<(KeyRank const &o) const { return key < o.key || (!(o.key < key) && rank < o.rank); }
+    bool operator>(KeyRank const &o) const { return o < *this; }
+};
+
+/*------------------------------------------------------
+结构名称：RadixTraits<T>
+结构功能：把整型/IEEE浮点元素映射为同宽度的无符号键，使键的无符号序与元素的序一致
+         有符号整数翻转符号位；浮点数负数全部取反、非负数翻转符号位
+*/
+template <size_t N> struct RadixUInt;
+template <> struct RadixUInt<1> { typedef unsigned char type; };
+template <> struct RadixUInt<2> { typedef unsigned short type; };
+template <> struct RadixUInt<4> { typedef unsigned int type; };
+template <> struct RadixUInt<8> { typedef unsigned long long type; };
+
+template <typename T, bool = std::is_integral<T>::value || std::is_floating_point<T>::value>
+struct RadixTraits
+{
+    static const bool enabled = false;
+};
 
 template <typename T>
+struct RadixTraits<T, true>
+{
+    static const bool enabled = sizeof(T) <= 8 &&
+                                (std::is_integral<T>::value ||
+                                 (std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8)));
+    typedef typename RadixUInt<enabled ? sizeof(T) : 8>::type U;
+    static U key(T const &e)
+    {
+        U u = 0;
+        memcpy(&u, &e, sizeof(T));
+        const U sign = U(1) << (8 * sizeof(U) - 1);
+        if (std::is_floating_point<T>::value)
+            return (u & sign) ? U(~u) : U(u ^ sign);
+        if (std::is_signed<T>::value)
+            return u ^ sign;
+        return u;
+    }
+};
+
+// #define Vector iyan_vector
+
+template <typename T, typename Alloc = std::allocator<T>>
 class Vector
-{ // 模板类 “向量”
+{ // 模板类 “向量”，Alloc为分配器（默认 std::allocator，即 ::operator new/delete）
+    template <typename, typename>
+    friend class Vector;
+
 protected:
     Rank _size;
     int _capacity;
-    T *_elem;                                    // 定义规模 ，容量 ，数据空间
+    T *_elem;                                    // 定义规模 ，容量 ，数据空间（仅[0,_size)中的元素已构造）
+    Alloc _alloc;                                // 分配器，元素空间与排序缓冲区均由它申请
+    CapacityPolicy _policy;                      // 扩容/缩容策略
+    CapacityStats _stats;                        // 重新分配计数
     void copyFrom(T const *A, Rank lo, Rank hi); // 定义复制数组区间   首地址,起始索引,结束索引  (A[lo,hi])
 
-    void expand(); // 扩容函数
-    void shrink(); // 缩容函数
+    T *allocate(int c);                            // 申请可容纳c个元素的未初始化空间
+    void deallocate(T *p, int c);                  // 释放allocate申请的空间
+    T *allocateBuffer(Rank n);                     // 申请n个元素的排序缓冲区（元素已构造，可直接赋值）
+    void deallocateBuffer(T *B, Rank n);           // 析构并释放排序缓冲区
+    static void relocate(T *dst, T *src, Rank n);  // 把src处n个元素搬到dst处的未初始化空间，src处元素随之析构
+    void destroy(Rank lo, Rank hi);                // 析构区间[lo,hi)的元素
+    void reallocate(int c);                        // 换用容量为c的新空间
+
+    int grownCapacity(int c) const; // 容量c按策略扩大后的值，至多为int上限
+    void expand();                  // 扩容函数
+    void shrink();                  // 缩容函数
 
     bool bubble(Rank lo, Rank hi);     // 扫描交换
     void bubbleSort(Rank lo, Rank hi); // 冒泡排序函数 范围（lo --> hi）
@@ -27,38 +221,77 @@ protected:
 
     void selectionSort(Rank lo, Rank hi); // 选择排序函数 范围（lo --> hi）
 
-    void merge(Rank lo, Rank mi, Rank hi);
-    void mergeSort(Rank lo, Rank hi); // 归并排序函数 low，middle，high
+    void merge(Rank lo, Rank mi, Rank hi, T *B); // 二路归并，B为暂存前子向量的缓冲区
+    void mergeSort(Rank lo, Rank hi);            // 归并排序函数 low，middle，high
+
+    void insertionSort(Rank lo, Rank hi); // 插入排序函数 范围（lo --> hi）
+
+    Rank median3(Rank a, Rank b, Rank c) const; // 三者取中，返回中位数的秩
+    Rank partition(Rank lo, Rank hi);           // 轴点构造函数，返回轴点的秩
+
+    void quickSort(Rank lo, Rank hi);                // 快排函数（内省排序入口）
+    void introSort(Rank lo, Rank hi, int depthLimit); // 内省排序：快排 + 堆排兜底 + 插入排序收尾
 
-    Rank partition(Rank lo, Rank hi); // 轴点构造函数 （？）
+    void percolateDown(Rank lo, Rank n, Rank i); // 堆[lo,lo+n)中自i下滤
+    void heapSort(Rank lo, Rank hi);             // 堆排序函数
 
-    void quickSort(Rank lo, Rank hi); // 快排函数
+    Rank coRank(Rank k, Rank lo, Rank mi, Rank hi) const;                // 归并结果前k个元素中来自[lo,mi)者的数目
+    void parallelMerge(Rank lo, Rank mi, Rank hi, T *W, int threads);    // 并行二路归并，W为(hi-lo)规模的缓冲区
+    void parallelMergeSort(Rank lo, Rank hi, T *W, int threads);         // 并行归并排序
+    void sampleSort(Rank lo, Rank hi, int threads);                      // 并行样本排序
 
-    void heapSort(Rank lo, Rank hi); // 堆排序函数
+    void radixSort(Rank lo, Rank hi); // 基数排序（LSD，逐字节），仅对整型/浮点元素，其余类型转快排
+
+    Rank nextRun(Rank lo, Rank hi);               // 识别自lo起的顺序段（逆序段就地翻转），不足 MIN_RUN 者补足，返回段尾
+    void mergeRuns(Rank lo, Rank mi, Rank hi, T *B); // 合并相邻有序段，跳跃式推进；B至少容纳较短段
+    void naturalMergeSort(Rank lo, Rank hi);      // 自然归并排序（powersort）
 
 public:
     // 构造函数
-    Vector(int c = DEFAULT_CAPACITY, int s = 0, T const &v = 0) // 容量：c，规模：s，元素：v
+    Vector(int c = DEFAULT_CAPACITY, int s = 0, T const &v = T()) // 容量：c，规模：s，元素：v
     {
-        _elem = new T[_capacity = c];
-        for (_size = 0; _size < s; _elem[_size++] = v)
-            ;
+        _elem = allocate(_capacity = c);
+        for (_size = 0; _size < s; _size++)
+            new (_elem + _size) T(v);
     } // 定义存储空间，初始化存储空间
 
     // 拷贝构造函数
     Vector(T const *A, Rank lo, Rank hi) { copyFrom(A, lo, hi); }               // 数组区间复制
     Vector(T const *A, Rank n) { copyFrom(A, 0, n); }                           // 数组整体复制
-    Vector(Vector<T> const &V, Rank lo, Rank hi) { copyFrom(V._elem, lo, hi); } // 向量区间复制
-    Vector(Vector<T> const &V) { copyFrom(V._elem, 0, V._size); }               // 向量整体复制
+    Vector(Vector const &V, Rank lo, Rank hi) : _alloc(V._alloc), _policy(V._policy) { copyFrom(V._elem, lo, hi); } // 向量区间复制
+    Vector(Vector const &V) : _alloc(V._alloc), _policy(V._policy) { copyFrom(V._elem, 0, V._size); }               // 向量整体复制
+
+    // 移动构造函数：直接接管V的空间，V置空
+    Vector(Vector &&V) noexcept
+        : _size(V._size), _capacity(V._capacity), _elem(V._elem), _alloc(std::move(V._alloc)), _policy(V._policy)
+    {
+        V._elem = nullptr;
+        V._size = V._capacity = 0;
+    }
+
+    explicit Vector(Alloc const &alloc, int c = DEFAULT_CAPACITY) : _alloc(alloc) // 指定分配器（如某个竞技场）
+    {
+        _elem = allocate(_capacity = c);
+        _size = 0;
+    }
 
     // 析构函数
-    ~Vector() { delete[] _elem; } // 释放储存空间
+    ~Vector()
+    {
+        destroy(0, _size);
+        deallocate(_elem, _capacity);
+    } // 析构元素，释放储存空间
 
     // 只读访问接口
     void push_Back(T const &e);           // 添加元素
+    void push_Back(T &&e);                // 添加元素（移动）
+    template <typename... Args>
+    void emplace_Back(Args &&...args);    // 在尾部就地构造元素
     Rank size() const { return _size; }   // 查询规模
+    int capacity() const { return _capacity; } // 查询容量
     bool empty() const { return !_size; } // 查询是否为空
     int disordered() const;               // 向量是否排序过标志位
+    bool isSorted() const { return simdIsSorted(_elem, _size); } // 是否整体有序（遇逆序即返回）
 
     Rank find(T const &e) const { return find(e, 0, _size); } // 无序向量整体查找
     Rank find(T const &e, Rank lo, Rank hi) const;            // 无序向量区间查找
@@ -67,81 +300,292 @@ public:
     { return (0 >= _size) ? -1 : search(e, 0, _size); } // 向量整体查找
     Rank search(T const &e, Rank lo, Rank hi) const; // 向量区间查找 lo -> hi
 
+    Rank lowerBound(T const &e) const { return lowerBound(e, 0, _size); } // 有序向量中首个不小于e的秩
+    Rank lowerBound(T const &e, Rank lo, Rank hi) const;                  // 有序区间中首个不小于e的秩，无则为hi
+    Rank upperBound(T const &e) const { return upperBound(e, 0, _size); } // 有序向量中首个大于e的秩
+    Rank upperBound(T const &e, Rank lo, Rank hi) const;                  // 有序区间中首个大于e的秩，无则为hi
+    void searchBatch(T const *keys, Rank n, Rank *out) const;             // 批量查找：out[i] = search(keys[i])
+
+    VectorView<T> range(T const &loKey, T const &hiKey) const; // 有序向量中落在[loKey,hiKey)的区间视图
+    template <typename K, typename KeyFn>
+    VectorView<T> range(K const &loKey, K const &hiKey, KeyFn key) const; // 有序向量中key(e)落在[loKey,hiKey)的区间视图
+
     // 可访问接口
-    T &operator[](Rank r) const;          // 重载索引运算符，使得向量可以用类似数组的形式访问
-    Vector &operator=(Vector<T> const &); // 重载赋值运算符，赋值直接调用克隆向量
+    T &operator[](Rank r) const;          // 重载索引运算符，使得向量可以用类似数组的形式访问（VECTOR_CHECKED时检查越界）
+    T &at_unchecked(Rank r) const { return _elem[r]; } // 不检查越界的访问，供热点循环使用
+    T *data() const { return _elem; }                  // 元素空间首地址，[data(), data() + size())
+    T *begin() const { return _elem; }                 // 随机访问迭代器，可直接用于 std:: 算法
+    T *end() const { return _elem + _size; }
+    Vector &operator=(Vector const &); // 重载赋值运算符，赋值直接调用克隆向量
+    Vector &operator=(Vector &&) noexcept; // 移动赋值，接管右值向量的空间（连同分配器）
+
+    // 容量管理
+    void reserve(int c);  // 预留容量至少为c，之后规模不超过c的插入不再重新分配
+    void shrink_to_fit(); // 容量收紧到规模
+    void clear()          // 析构全部元素，保留容量
+    {
+        destroy(0, _size);
+        _size = 0;
+    }
+    void setPolicy(CapacityPolicy const &policy) { _policy = policy; } // 设置扩容/缩容策略
+    CapacityPolicy const &policy() const { return _policy; }
+    CapacityStats const &capacityStats() const { return _stats; } // 重新分配计数
+    void resetCapacityStats() { _stats = CapacityStats(); }
 
     T remove(Rank r);             // remove函数,删除秩为r的元素
     int remove(Rank lo, Rank hi); // 重载remove函数,删除区间[lo,hi)的元素
-
+    template <typename Pred>
+    int remove_if(Pred pred);                          // 删除所有满足pred的元素，一趟紧凑，返回删除数
+    int removeIndices(Rank const *ranks, Rank m);      // 批量删除秩为ranks[0,m)（升序）的元素，返回删除数
+    int removeIndices(Vector<Rank> const &ranks)       // 同上，秩由升序向量给出
+    { return removeIndices(ranks.data(), ranks.size()); }
+
+    Rank insert(Rank r, T &&e);                          // 插入元素e（移动）
+    template <typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    Rank insert(Rank r, It first, It last);              // 在秩r处批量插入[first,last)，尾部只移动一次
     Rank insert(Rank r, T const &e);                     // 插入元素e，在秩为r的首地址插入    Rank insert(T const &e) { return insert(_size, e); } // 重载insert函数，当唯一参数时，默认在末尾插入
 
     void sort(Rank lo, Rank hi, int ID); // 区间排序  lo -> hi
     void sort(int ID) { sort(0, _size, ID); }      // 整体排序,默认归并
+    void stableSort(Rank lo, Rank hi);                   // 稳定区间排序：相等元素保持原有的相对次序
+    void stableSort() { stableSort(0, _size); }          // 稳定整体排序
+    void unstableSort(Rank lo, Rank hi) { sort(lo, hi, 0); } // 不保证稳定的区间排序，取最快的串行算法
+    void unstableSort() { unstableSort(0, _size); }          // 不保证稳定的整体排序
+    void mergeSort(Rank lo, Rank hi, T *B);        // 使用调用者提供的缓冲区B（至少(hi-lo)/2个元素）归并排序
+    void parallelSort(Rank lo, Rank hi, int threads = 0);          // 多线程区间排序，threads为0时取硬件线程数
+    void parallelSort(int threads = 0) { parallelSort(0, _size, threads); } // 多线程整体排序
+
+    template <typename KeyFn>
+    void sortByKey(Rank lo, Rank hi, KeyFn key); // 按键区间排序：每个元素只算一次键，稳定
+    template <typename KeyFn>
+    void sortByKey(KeyFn key) { sortByKey(0, _size, key); } // 按键整体排序
 
     
-    void unsort(Rank lo, Rank hi);      // 区间打乱， lo -> hi
-    void unsort() { unsort(0, _size); } // 整体打乱
-
-    int deduplicate(); // 无序去重
+    void unsort(Rank lo, Rank hi, Xoshiro256 &rng);                  // 以rng区间打乱（Fisher-Yates）， lo -> hi
+    void unsort(Rank lo, Rank hi) { unsort(lo, hi, Xoshiro256::local()); } // 区间打乱，用当前线程的生成器
+    void unsort() { unsort(0, _size); }                              // 整体打乱
+    void parallelUnsort(Rank lo, Rank hi, uint64_t seed, int threads = 0); // 多线程区间打乱，结果只取决于seed
+    void parallelUnsort(uint64_t seed, int threads = 0) { parallelUnsort(0, _size, seed, threads); }
+
+    int deduplicate(); // 无序去重：元素可用 std::hash 散列时期望 O(n)，否则 O(n^2)
+    template <typename Hash>
+    int deduplicate(Hash hash); // 以hash为散列函数的无序去重，期望 O(n)，保留各值首次出现者及其次序
     int uniquify();    // 有序去重
 
     // 遍历
     void traverse(void (*)(T &)); // 传入函数指针，遍历
     template <typename VST>
     void traverse(VST &); // 传入函数对象，遍历
+
+    // 并行遍历、映射与归约：threads为0时取硬件线程数；visit、f、map、op会被多个线程同时调用
+    template <typename VST>
+    void parallelTraverse(VST const &visit, int threads = 0, Schedule s = STATIC_SCHEDULE); // 对每个元素并行调用visit(e)
+    template <typename F>
+    void transform(F const &f, int threads = 0, Schedule s = STATIC_SCHEDULE); // 并行映射：e = f(e)
+    template <typename R, typename Map, typename Op>
+    R mapReduce(R identity, Map const &map, Op const &op, int threads = 0, Schedule s = STATIC_SCHEDULE) const; // op归约各map(e)
+    template <typename R, typename Op>
+    R reduce(R identity, Op const &op, int threads = 0, Schedule s = STATIC_SCHEDULE) const // op归约各元素
+    {
+        return mapReduce(identity, [](T const &e) -> T const & { return e; }, op, threads, s);
+    }
 };
 
 /*-------------------------------------------------------
  * 函数名称：push_Back(T const& e)
  * 函数功能：向量尾部增加元素
  */
-template <typename T>
-void Vector<T>::push_Back(T const &value)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::push_Back(T const &value)
 { // 添加元素
+    emplace_Back(value);
+}
+
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::push_Back(T &&value)
+{ // 添加元素（移动）
+    emplace_Back(std::move(value));
+}
+
+/*-------------------------------------------------------
+ * 函数名称：emplace_Back(Args&&... args)
+ * 函数功能：以args在向量尾部就地构造元素
+ */
+template <typename T, typename Alloc>
+template <typename... Args>
+void Vector<T, Alloc>::emplace_Back(Args &&...args)
+{
     if (_size == _capacity)
-        expand(); // 需要扩容
-    _elem[_size++] = value;
+    { // 需要扩容：参数可能引用本向量中的元素，先构造好再扩容
+        T e(std::forward<Args>(args)...);
+        expand();
+        new (_elem + _size++) T(std::move(e));
+        return;
+    }
+    new (_elem + _size++) T(std::forward<Args>(args)...);
+}
+
+/*------------------------------------------------------
+函数名称：allocate(int c) / deallocate(T* p)
+函数功能：申请/释放未初始化的元素空间，不调用构造/析构函数
+*/
+template <typename T, typename Alloc>
+T *Vector<T, Alloc>::allocate(int c)
+{
+    return std::allocator_traits<Alloc>::allocate(_alloc, c);
+}
+
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::deallocate(T *p, int c)
+{
+    if (p)
+        std::allocator_traits<Alloc>::deallocate(_alloc, p, c);
+}
+
+/*------------------------------------------------------
+函数名称：allocateBuffer(Rank n) / deallocateBuffer(T* B, Rank n)
+函数功能：经分配器申请/释放排序用的缓冲区；非平凡类型的元素先默认构造，以便直接赋值
+*/
+template <typename T, typename Alloc>
+T *Vector<T, Alloc>::allocateBuffer(Rank n)
+{
+    PerfTally tally;
+    tally.allocate();
+    T *B = allocate(n);
+    if (!std::is_trivially_default_constructible<T>::value)
+        for (Rank i = 0; i < n; i++)
+            new (B + i) T();
+    return B;
+}
+
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::deallocateBuffer(T *B, Rank n)
+{
+    if (!std::is_trivially_destructible<T>::value)
+        for (Rank i = 0; i < n; i++)
+            B[i].~T();
+    deallocate(B, n);
+}
+
+/*------------------------------------------------------
+函数名称：relocate(T* dst, T* src, Rank n)
+函数功能：把src处n个元素搬到dst处的未初始化空间
+         可平凡复制的类型直接 memcpy，否则逐个移动构造并析构原元素
+*/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::relocate(T *dst, T *src, Rank n)
+{
+    if (std::is_trivially_copyable<T>::value)
+    {
+        if (n > 0)
+            memcpy((void *)dst, (void const *)src, sizeof(T) * n);
+        return;
+    }
+    for (Rank i = 0; i < n; i++)
+    {
+        new (dst + i) T(std::move(src[i]));
+        src[i].~T();
+    }
+}
+
+/*------------------------------------------------------
+函数名称：destroy(Rank lo, Rank hi)
+函数功能：析构区间[lo,hi)的元素，空间不释放
+*/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::destroy(Rank lo, Rank hi)
+{
+    if (!std::is_trivially_destructible<T>::value)
+        while (lo < hi)
+            _elem[lo++].~T();
+}
+
+/*------------------------------------------------------
+函数名称：reallocate(int c)
+函数功能：申请容量为c的新空间，把元素搬过去，释放旧空间
+*/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::reallocate(int c)
+{
+    T *oldElem = _elem;
+    int oldCapacity = _capacity;
+    PerfTally tally;
+    tally.allocate();
+    tally.move(_size);
+    _stats.reallocs++;
+    _elem = allocate(_capacity = c);
+    relocate(_elem, oldElem, _size);
+    deallocate(oldElem, oldCapacity);
 }
 
 /*------------------------------------------------------
 函数名称：copyFrom(T const* A, Rank lo, Rank hi)
 函数功能：拷贝向量
 */
-template <typename T>
-void Vector<T>::copyFrom(T const *A, Rank lo, Rank hi)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::copyFrom(T const *A, Rank lo, Rank hi)
 { // 数组区间复制 lo -> hi
     /*template <typename T>         void     Vector<T>::                copyFrom(T const* A, Rank lo, Rank hi）*/
     /*自定义数据类型（int，char）    返回空    类外部定义函数的作用域声明     函数名                  参数         */
 
-    _elem = new T[_capacity = 2 * (hi - lo)]; // 申请预留两倍空间
-    _size = 0;                                // 初始化数据规模
-    while (lo < hi)                           // A[lo,hi]
-        _elem[_size++] = A[lo++];             // 复制至_elem[0,hi-lo]
+    _elem = allocate(_capacity = 2 * (hi - lo)); // 申请预留两倍空间
+    _size = hi - lo;                             // 数据规模
+    if (std::is_trivially_copyable<T>::value)
+    {
+        if (_size > 0)
+            memcpy((void *)_elem, (void const *)(A + lo), sizeof(T) * _size);
+        return;
+    }
+    for (Rank i = 0; lo < hi; i++)   // A[lo,hi]
+        new (_elem + i) T(A[lo++]);  // 复制构造至_elem[0,hi-lo]
 }
 
 /*------------------------------------------------------
 函数名称：operator=(Vector<T> const& V)
-函数功能：重载赋值运算符
+函数功能：重载赋值运算符；容量策略随之复制（与复制构造一致），重新分配计数属于本对象，不随赋值改变
 */
-template <typename T>
-Vector<T> &Vector<T>::operator=(Vector<T> const &V)
+template <typename T, typename Alloc>
+Vector<T, Alloc> &Vector<T, Alloc>::operator=(Vector<T, Alloc> const &V)
 { // 用成员函数方法，重载运算符
-    if (_elem)
-        delete[] _elem;            // 释放对象原有的空间
+    if (this == &V)
+        return *this; // 自我赋值
+    _policy = V._policy;
+    destroy(0, _size);
+    deallocate(_elem, _capacity);  // 释放对象原有的空间
     copyFrom(V._elem, 0, V._size); // 对已经清空的空间，整体赋值
     return *this;                  // 返回当前对象指针
 }
 
+/*------------------------------------------------------
+函数名称：operator=(Vector<T>&& V)
+函数功能：移动赋值，释放原有空间后直接接管V的空间，V置空
+*/
+template <typename T, typename Alloc>
+Vector<T, Alloc> &Vector<T, Alloc>::operator=(Vector<T, Alloc> &&V) noexcept
+{
+    if (this == &V)
+        return *this;
+    destroy(0, _size);
+    deallocate(_elem, _capacity);
+    _alloc = std::move(V._alloc);
+    _policy = V._policy;
+    _elem = V._elem, _size = V._size, _capacity = V._capacity;
+    V._elem = nullptr;
+    V._size = V._capacity = 0;
+    return *this;
+}
+
 /*------------------------------------------------------
 函数名称：operator[](Rank r)
-函数功能：重载[]运算符
+函数功能：重载[]运算符；VECTOR_CHECKED为1时越界抛出 std::out_of_range，为0时不检查
 */
-template <typename T>
-T &Vector<T>::operator[](Rank r) const
+template <typename T, typename Alloc>
+T &Vector<T, Alloc>::operator[](Rank r) const
 { // ！！！ T&指定索引的元素，使得可以通过改变如：v[i]来直接改变向量元素，而不只是一个拷贝
+#if VECTOR_CHECKED
     if (r < 0 || r >= _size)
         throw std::out_of_range("Index out of range");
+#endif
     return _elem[r]; // 返回对应索引的元素
 }
 
@@ -149,50 +593,159 @@ T &Vector<T>::operator[](Rank r) const
 函数名称：expand()
 函数功能：扩容
 */
-template <typename T>
-void Vector<T>::expand()
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::expand()
 { // 扩容函数
     if (_size < _capacity)
         return; // 容量未满，无需扩容
-    if (_capacity < DEFAULT_CAPACITY)
-        _capacity = DEFAULT_CAPACITY; // 如果当前空间小于默认空间，扩容到默认大小
-    T *oldElem = _elem;
-    _elem = new T[_capacity <<= 1]; // 扩容到原来的两倍
-    for (int i = 0; i < _size; i++)
-        _elem[i] = oldElem[i]; // 赋值原来的内容到新的空间
-    delete[] oldElem;          // 释放原有空间
+    int c = _capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : _capacity; // 如果当前空间小于默认空间，按默认大小计
+    VECTOR_PERF_SCOPE("expand");
+    int grown = grownCapacity(c); // 按策略扩容（默认为原来的两倍）
+    _stats.expands++;
+    reallocate(grown); // 元素搬到新空间
+}
+
+/*------------------------------------------------------
+函数名称：grownCapacity(int c)
+函数功能：容量c按扩容倍数放大后的值，至少为c+1
+         以long long计算，超出int上限时取上限；c已达上限、无从再扩时抛出 std::length_error
+*/
+template <typename T, typename Alloc>
+int Vector<T, Alloc>::grownCapacity(int c) const
+{
+    const int cap = std::numeric_limits<int>::max();
+    if (c >= cap)
+        throw std::length_error("Vector: capacity exceeds INT_MAX");
+    long long grown = (long long)(c * _policy.growth); // growth 不超过 MAX_GROWTH，乘积在long long范围内
+    if (grown > cap)
+        grown = cap;
+    return grown > c ? (int)grown : c + 1;
 }
 
 /*------------------------------------------------------
 函数名称：shrink()
 函数功能：缩容
 */
-template <typename T>
-void Vector<T>::shrink()
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::shrink()
 {
+    if (!_policy.shrinkRatio)
+        return; // 策略为从不缩容
     if (_capacity < DEFAULT_CAPACITY << 1)
         return; // 不至于缩容到默认容量（<<2联系上文是默认预留冗余）
-    if (_size << 2 > _capacity)
-        return;                     // 内容已经达到容器设计极限的1/4，无需缩容
-    T *oldElem = _elem;             // 把原本空间里的内容暂存中介
-    _elem = new T[_capacity >>= 1]; // 扩容为原来的两倍
-    for (int i = 0; i < _size; i++)
-        _elem[i] = oldElem[i]; // 把原来的内容从中介搬到到新的空间
-    delete[] oldElem;          // 释放中介空间
+    if ((long long)_size * _policy.shrinkRatio > _capacity)
+        return; // 装填因子未低于 1/shrinkRatio（默认1/4），无需缩容
+    VECTOR_PERF_SCOPE("shrink");
+    int c = (int)(_capacity / _policy.growth); // 缩容（默认为原来的一半）
+    if (c < DEFAULT_CAPACITY)
+        c = DEFAULT_CAPACITY;
+    _stats.shrinks++;
+    reallocate(c); // 元素搬到新空间
 }
 
+/*------------------------------------------------------
+函数名称：reserve(int c)
+函数功能：预留容量至少为c，已够则什么也不做
+*/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::reserve(int c)
+{
+    if (c > _capacity)
+        reallocate(c);
+}
 
 /*------------------------------------------------------
-函数名称：unsort(Rank lo, Rank hi)
-函数功能：区间置乱函数接口
+函数名称：shrink_to_fit()
+函数功能：容量收紧到与规模相等
 */
-template <typename T>
-void Vector<T>::unsort(Rank lo, Rank hi)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::shrink_to_fit()
+{
+    if (_capacity > _size)
+        reallocate(_size);
+}
+
+
+/*------------------------------------------------------
+函数名称：unsort(Rank lo, Rank hi, Xoshiro256& rng)
+函数功能：区间置乱函数接口：Fisher-Yates，自后向前把V[i-1]与V[0,i)中均匀选出的一个交换
+         各排列等概率（rng.bounded无偏）；同一状态的rng总得到同一排列
+*/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::unsort(Rank lo, Rank hi, Xoshiro256 &rng)
 {
     T *V = _elem + lo;
-    while (lo < --hi)
-        swap(V[lo++], V[rand() % (hi - lo + 1) + lo]); 
-    
+    for (Rank i = hi - lo; i > 1; i--)
+        swap(V[i - 1], V[rng.bounded(i)]);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name parallelUnsort(Rank lo, Rank hi, uint64_t seed, int threads)
+ * @brief 多线程置乱（随机分桶 + 桶内 Fisher-Yates）
+ * @param uint64_t seed 种子：同一种子、同一区间规模总得到同一排列，与线程数无关
+ * @note 1. 区间按 SHUFFLE_BLOCK 切成K块，第b块用流b为每个元素均匀抽一个桶号；
+ *          先计数、再以同一条流重抽一遍把元素分发到缓冲区（不必存下桶号）
+ *       2. 各桶用流K+k各自做 Fisher-Yates，再搬回原处
+ *       3. 桶号独立同分布、桶内排列均匀，合起来即为均匀随机排列
+ *       4. 规模不足两块时退化为以seed为种子的串行置乱
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::parallelUnsort(Rank lo, Rank hi, uint64_t seed, int threads)
+{
+    Rank n = hi - lo;
+    if (n < 2 * SHUFFLE_BLOCK)
+    {
+        Xoshiro256 rng(seed);
+        unsort(lo, hi, rng);
+        return;
+    }
+    if (threads <= 0)
+        threads = hardwareThreads();
+    Rank K = (n + SHUFFLE_BLOCK - 1) / SHUFFLE_BLOCK; // 块数
+    Rank B = n / SHUFFLE_BLOCK;                       // 桶数，每桶期望不少于一块
+    if (B > SHUFFLE_BUCKETS)
+        B = SHUFFLE_BUCKETS;
+    T *A = _elem + lo;
+    T *W = allocateBuffer(n);
+    Vector<Rank> count(K * B, K * B, 0); // count[b*B+k]：第b块落入第k桶的元素数，前缀和后为其写入位置
+    Vector<Rank> start(B + 1, B + 1, 0); // 第k桶为W[start[k], start[k+1])
+    Rank *C = count.data(), *S = start.data();
+
+    parallelChunks(K, threads, DYNAMIC_SCHEDULE, 1, [&](long long b, long long, long long) { // 1. 计数
+        Xoshiro256 rng(seed, b);
+        Rank *c = C + b * B;
+        Rank end = (Rank)(b + 1 < K ? (b + 1) * SHUFFLE_BLOCK : n);
+        for (Rank i = (Rank)b * SHUFFLE_BLOCK; i < end; i++)
+            c[rng.bounded(B)]++;
+    });
+    for (Rank k = 0, off = 0; k < B; k++)
+    { // 按（桶，块）的次序求前缀和
+        S[k] = off;
+        for (Rank b = 0; b < K; b++)
+        {
+            Rank t = C[b * B + k];
+            C[b * B + k] = off;
+            off += t;
+        }
+        S[k + 1] = off;
+    }
+    parallelChunks(K, threads, DYNAMIC_SCHEDULE, 1, [&](long long b, long long, long long) { // 2. 重抽同样的桶号，分发
+        Xoshiro256 rng(seed, b);
+        Rank *c = C + b * B;
+        Rank end = (Rank)(b + 1 < K ? (b + 1) * SHUFFLE_BLOCK : n);
+        for (Rank i = (Rank)b * SHUFFLE_BLOCK; i < end; i++)
+            W[c[rng.bounded(B)]++] = std::move(A[i]);
+    });
+    parallelChunks(B, threads, DYNAMIC_SCHEDULE, 1, [&](long long k, long long, long long) { // 3. 桶内置乱并搬回
+        Xoshiro256 rng(seed, K + k);
+        T *V = W + S[k];
+        for (Rank i = S[k + 1] - S[k]; i > 1; i--)
+            swap(V[i - 1], V[rng.bounded(i)]);
+        for (Rank i = S[k]; i < S[k + 1]; i++)
+            A[i] = std::move(W[i]);
+    });
+    deallocateBuffer(W, n);
 }
 
 /*------------------------------------------------------
@@ -213,28 +766,40 @@ static bool eq(T &a, T &b) { return a == b; }
 /*------------------------------------------------------
 函数名称：find(T const& e, Rank lo, Rank hi) const
 函数功能：无序向量的顺序查找
+         算术类型元素按运行时检测到的指令集一次比较多个元素（见 VectorSimd.h）
 */
-template <typename T>
-Rank Vector<T>::find(T const &e, Rank lo, Rank hi) const
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::find(T const &e, Rank lo, Rank hi) const
 { // 要查找的元素引用（可以是结构体等较大的数据类型，用引用节省空间），查找区间
-    while ((lo < hi--) && (e != _elem[hi]));      // 从hi末尾向前查找
-    return hi; // 返回查找到的索引，若无，返回-1
+    return simdFind(_elem, e, lo, hi); // 从hi末尾向前查找，返回查找到的索引，若无，返回lo-1
 }
 
 /*---------------------------------------------------------
  * 函数名称：insert(Rank r, T const& e)    //rank，value
  * 函数功能：插入
  */
-template <typename T>
-Rank Vector<T>::insert(Rank r, T const &e)
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::insert(Rank r, T const &e)
+{
+    return insert(r, T(e)); // e可能引用本向量中的元素，先复制一份
+}
+
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::insert(Rank r, T &&e)
 {
     expand(); // 如有必要，扩容
-    for (int i = _size; i > r; i--)
+    if (r == _size)
+    {
+        new (_elem + _size++) T(std::move(e));
+        return r;
+    }
+    new (_elem + _size) T(std::move(_elem[_size - 1])); // 末元素移入尚未构造的新位置
+    for (int i = _size - 1; i > r; i--)
     {
         
-        _elem[i] = _elem[i - 1]; // 从 最后一个 到 第r个 把每个元素后移一位
+        _elem[i] = std::move(_elem[i - 1]); // 从 最后一个 到 第r个 把每个元素后移一位
     }
-    _elem[r] = e;
+    _elem[r] = std::move(e);
     _size++; // 总体数据规模 +1
     return r;
 }
@@ -243,25 +808,124 @@ Rank Vector<T>::insert(Rank r, T const &e)
  * 函数名称：remove(Rank lo, Rank hi)
  * 函数功能：区间删除函数接口
  */
-template <typename T>
-Rank Vector<T>::remove(Rank lo, Rank hi)
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::remove(Rank lo, Rank hi)
 { // 返回删除区间的元素个数
     if (lo == hi)
         return 0; // 删除区间为空，无元素被删除,直接退出
     while (hi < _size)
-        _elem[lo++] = _elem[hi++]; // 把区间后面的元素挨个复制到前面位置
-    _size -= hi - lo;              // 规模减小
-    shrink();                      // 如有必要缩容量
+        _elem[lo++] = std::move(_elem[hi++]); // 把区间后面的元素挨个移到前面位置
+    destroy(lo, _size);                       // 析构空出的尾部
+    _size -= hi - lo;                         // 规模减小
+    shrink();                                 // 如有必要缩容量
     return hi - lo;
 }
+/*---------------------------------------------------------
+ * 函数名称：insert(Rank r, It first, It last)
+ * 函数功能：批量插入，[first,last)依次插到秩r起的位置
+ * 至多重新分配一次，尾部元素整体后移一次，O(n + k)
+ * [first,last)不得指向本向量中的元素
+ */
+template <typename T, typename Alloc>
+template <typename It, typename>
+Rank Vector<T, Alloc>::insert(Rank r, It first, It last)
+{
+    Rank k = (Rank)std::distance(first, last);
+    if (k <= 0)
+        return r;
+    if ((long long)_size + k > std::numeric_limits<int>::max())
+        throw std::length_error("Vector::insert: size exceeds INT_MAX");
+    if (_size + k > _capacity)
+    { // 按扩容策略一次扩到足够大
+        int c = _capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : _capacity;
+        while (c < _size + k)
+            c = grownCapacity(c);
+        _stats.expands++;
+        reallocate(c);
+    }
+    if (std::is_trivially_copyable<T>::value)
+        memmove((void *)(_elem + r + k), (void const *)(_elem + r), sizeof(T) * (_size - r)); // 尾部整体后移
+    else
+        for (Rank i = _size - 1; i >= r; i--)
+        { // 尾部自后向前后移k位：落在原规模之外的位置尚未构造
+            if (i + k >= _size)
+                new (_elem + i + k) T(std::move(_elem[i]));
+            else
+                _elem[i + k] = std::move(_elem[i]);
+        }
+    for (Rank i = r; i < r + k; i++, ++first)
+    { // 填入新元素
+        if (i < _size && !std::is_trivially_copyable<T>::value)
+            _elem[i] = *first;
+        else
+            new (_elem + i) T(*first);
+    }
+    _size += k;
+    return r;
+}
+
+/*-------------------------------------------------------
+ * 函数名称：remove_if(Pred pred)
+ * 函数功能：删除所有满足pred的元素，其余元素保持次序
+ * 一趟扫描，保留者紧凑前移，最后一次性删除尾部，O(n)
+ */
+template <typename T, typename Alloc>
+template <typename Pred>
+int Vector<T, Alloc>::remove_if(Pred pred)
+{
+    Rank k = 0; // [0,k)为保留的元素
+    for (Rank i = 0; i < _size; i++)
+        if (!pred(_elem[i]))
+        {
+            if (k != i)
+                _elem[k] = std::move(_elem[i]);
+            k++;
+        }
+    return remove(k, _size);
+}
+
+/*-------------------------------------------------------
+ * 函数名称：removeIndices(Rank const* ranks, Rank m)
+ * 函数功能：批量删除秩为ranks[0,m)的元素，ranks须升序且在[0,size)内（重复者只删一次）
+ * 自第一个待删位置起一趟紧凑，O(n + m)
+ * VECTOR_CHECKED为1时，ranks不升序或越界抛出 std::out_of_range，向量不变；
+ * 为0时不检查，越界的秩忽略（负者跳过，首个不小于size()者及其后的秩不再处理）
+ */
+template <typename T, typename Alloc>
+int Vector<T, Alloc>::removeIndices(Rank const *ranks, Rank m)
+{
+#if VECTOR_CHECKED
+    for (Rank j = 0; j < m; j++)
+        if (ranks[j] < 0 || ranks[j] >= _size || (j > 0 && ranks[j] < ranks[j - 1]))
+            throw std::out_of_range("removeIndices: ranks must be ascending and within [0, size)");
+#endif
+    Rank j = 0; // ranks[j]为下一个待删的秩
+    while (j < m && ranks[j] < 0)
+        j++;
+    if (j == m || ranks[j] >= _size)
+        return 0;
+    Rank k = ranks[j]; // [0,k)为保留的元素
+    for (Rank i = k; i < _size; i++)
+    {
+        if (j < m && i == ranks[j])
+        { // 待删，跳过
+            while (j < m && ranks[j] == i)
+                j++;
+            continue;
+        }
+        _elem[k++] = std::move(_elem[i]);
+    }
+    return remove(k, _size);
+}
+
 /*-------------------------------------------------------
  * 函数名称：remove(Rank r)
  * 函数功能：从区间remove() 重载的单元素删除接口
  */
-template <typename T>
-T Vector<T>::remove(Rank r)
+template <typename T, typename Alloc>
+T Vector<T, Alloc>::remove(Rank r)
 { // 默认插入到末尾
-    T e = _elem[r];
+    T e = std::move(_elem[r]);
     remove(r, r + 1); // 单元素删除
     return e;         // 返回被删除的元素
 }
@@ -269,34 +933,90 @@ T Vector<T>::remove(Rank r)
 /*-------------------------------------------------------
  * 函数名称：deplicate()
  * 函数功能：向量去重
+ * 元素可用 std::hash 散列时转散列版本，否则逐个在前缀中查找
  */
-template <typename T>
-int Vector<T>::deduplicate()
+template <typename T, typename Alloc>
+int Vector<T, Alloc>::deduplicate()
 {
+    if constexpr (IsStdHashable<T>::value)
+        return deduplicate(std::hash<T>());
+    else
+    { // 不可散列：O(n^2)版本，逐个在前缀中查找
+        VECTOR_PERF_SCOPE("deduplicate");
+        int oldSize = _size; // 记录原规模
+        Rank i = 1;          // 从第2个元素开始
+        PerfTally tally;
+        while (i < _size)
+        {
+            Rank r = find(_elem[i], 0, i);
+            tally.compare(r < 0 ? i : i - r); // find 自后向前逐个比较
+            if (r < 0)
+                i++;
+            else
+            {
+                tally.move(_size - i - 1);
+                remove(i);
+            }
+        }
+        return oldSize - _size; // 返回被删去的数量
+    }
+}
 
-    // 对于无序的O(n^2)版本
-    int oldSize = _size;                               // 记录原规模
-    Rank i = 1;     
-    while (i < _size) {
-        if (find(_elem[i], 0, i) < 0) // 从第2个元素开始
-            i++;     // 从后向前，逐个检查
-        else
-            remove(i);                                     
-    }        
+/*-------------------------------------------------------
+ * 函数名称：deduplicate(Hash hash)
+ * 函数功能：散列去重，期望 O(n)
+ * 开放定址（线性试探）散列表记录已保留元素的秩，装填因子不超过1/2
+ * 一趟扫描：未见过的元素紧凑前移并登记，见过的跳过；最后一次性删除尾部
+ */
+template <typename T, typename Alloc>
+template <typename Hash>
+int Vector<T, Alloc>::deduplicate(Hash hash)
+{
+    VECTOR_PERF_SCOPE("deduplicate");
+    int oldSize = _size;
+    Rank cap = 16;
+    while (cap < 2 * _size)
+        cap <<= 1;
+    Vector<Rank> table(cap, cap, -1); // 槽中存已保留元素的秩，-1为空
+    Rank *slot = table.data();
+
+    Rank k = 0; // [0,k)为已保留的元素
+    PerfTally tally;
+    for (Rank i = 0; i < _size; i++)
+    {
+        size_t h = hashMix(hash(_elem[i])) & (cap - 1);
+        while (slot[h] >= 0 && !tally.equal(_elem[slot[h]], _elem[i]))
+            h = (h + 1) & (cap - 1); // 线性试探
+        if (slot[h] >= 0)
+            continue; // 重复，跳过
+        slot[h] = k;
+        if (k != i)
+        {
+            _elem[k] = std::move(_elem[i]); // 紧凑前移
+            tally.move(1);
+        }
+        k++;
+    }
+    remove(k, _size);       // 一次性删除尾部
     return oldSize - _size; // 返回被删去的数量
 }
 
-template <typename T>
-int Vector<T>::uniquify()
+template <typename T, typename Alloc>
+int Vector<T, Alloc>::uniquify()
 {
     // 对于有序向量的 O(n)版本
+    VECTOR_PERF_SCOPE("uniquify");
     int p1 = 0, p2 = p1;
     int oldSize = _size;
+    PerfTally tally;
     while (p2 < _size - 1 && p1 <= p2)
     {
         p2++;
-        if (_elem[p2] != _elem[p1])
+        if (!tally.equal(_elem[p2], _elem[p1]))
+        {
             _elem[++p1] = _elem[p2];
+            tally.move(1);
+        }
     }
     remove(++p1, _size); // 区间删除
     shrink();
@@ -307,8 +1027,8 @@ int Vector<T>::uniquify()
  * 函数名称：traverse(void (*visit)(T&))
  * 函数功能：使用函数指针，遍历所有元素
  */
-template <typename T>
-void Vector<T>::traverse(void (*visit)(T &))
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::traverse(void (*visit)(T &))
 { // 利用函数指针，遍历所有元素
     for (int i = 0; i < _size; i++)
         visit(_elem[i]);
@@ -318,14 +1038,82 @@ void Vector<T>::traverse(void (*visit)(T &))
  * 函数名称：traverse(VST& visit)
  * 函数功能：使用向量模板类，遍历所有元素
  */
-template <typename T>
+template <typename T, typename Alloc>
 template <typename VST>
-void Vector<T>::traverse(VST &visit)
+void Vector<T, Alloc>::traverse(VST &visit)
 { // 利用函数对象，遍历所有元素
     for (int i = 0; i < _size; i++)
         visit(_elem[i]); // visit函数对象，在遍历中运算
 }
 
+/*-------------------------------------------------------
+ * 函数名称：parallelTraverse(VST const& visit, int threads, Schedule s)
+ * 函数功能：并行遍历：按调度方式s把[0,_size)切块分给各线程，块内顺序调用visit
+ *          规模不足 PARALLEL_CUTOFF 时在当前线程内完成
+ */
+template <typename T, typename Alloc>
+template <typename VST>
+void Vector<T, Alloc>::parallelTraverse(VST const &visit, int threads, Schedule s)
+{
+    if (threads <= 0)
+        threads = hardwareThreads();
+    if (_size < PARALLEL_CUTOFF)
+        threads = 1;
+    T *A = _elem;
+    parallelChunks(_size, threads, s, PARALLEL_GRAIN, [&](long long, long long lo, long long hi) {
+        for (long long i = lo; i < hi; i++)
+            visit(A[i]);
+    });
+}
+
+/*-------------------------------------------------------
+ * 函数名称：transform(F const& f, int threads, Schedule s)
+ * 函数功能：并行映射：每个元素替换为f(e)；块内为简单的逐元素循环，f可内联时编译器可向量化
+ */
+template <typename T, typename Alloc>
+template <typename F>
+void Vector<T, Alloc>::transform(F const &f, int threads, Schedule s)
+{
+    if (threads <= 0)
+        threads = hardwareThreads();
+    if (_size < PARALLEL_CUTOFF)
+        threads = 1;
+    T *A = _elem;
+    parallelChunks(_size, threads, s, PARALLEL_GRAIN, [&](long long, long long lo, long long hi) {
+        for (long long i = lo; i < hi; i++)
+            A[i] = f(A[i]);
+    });
+}
+
+/*-------------------------------------------------------
+ * 函数名称：mapReduce(R identity, Map const& map, Op const& op, int threads, Schedule s) const
+ * 函数功能：并行归约：各块从identity出发以 acc = op(acc, map(e)) 求部分结果，
+ *          再按块号依次 op 合并；identity须为op的单位元，op须满足结合律
+ *          部分结果按块号而非完成次序合并，同样的threads与s下结果确定（浮点求和亦然）
+ */
+template <typename T, typename Alloc>
+template <typename R, typename Map, typename Op>
+R Vector<T, Alloc>::mapReduce(R identity, Map const &map, Op const &op, int threads, Schedule s) const
+{
+    if (threads <= 0)
+        threads = hardwareThreads();
+    if (_size < PARALLEL_CUTOFF)
+        threads = 1;
+    long long chunks = chunkCount(_size, threads, s, PARALLEL_GRAIN);
+    Vector<R> partial((int)chunks, (int)chunks, identity); // 各块的部分结果
+    T const *A = _elem;
+    parallelChunks(_size, threads, s, PARALLEL_GRAIN, [&](long long c, long long lo, long long hi) {
+        R acc = identity;
+        for (long long i = lo; i < hi; i++)
+            acc = op(acc, map(A[i]));
+        partial[(Rank)c] = acc;
+    });
+    R result = identity;
+    for (Rank c = 0; c < (Rank)chunks; c++)
+        result = op(result, partial[c]);
+    return result;
+}
+
 /*-------------------------------------------------------
  * 函数名称：increase(Vector<T>&)
  * 函数功能 递增一个T类对象中的元素
@@ -333,11 +1121,11 @@ void Vector<T>::traverse(VST &visit)
 template <typename T>
 struct Increase
 {
-    virtual void operator()(T &e) const { ++e; }
+    void operator()(T &e) const { ++e; } // 非虚函数，traverse中可内联、向量化
 }; // 重载Increase的（），为++；
 
-template <typename T>
-void increase(Vector<T> &V)
+template <typename T, typename Alloc>
+void increase(Vector<T, Alloc> &V)
 {
     Increase<T> increaser;
     V.traverse(increaser); // 调用traverse，遍历所有元素，调用重载的（）
@@ -350,42 +1138,62 @@ void increase(Vector<T> &V)
  * 函数名称：disordered()
  * 函数功能：整体有序性甄别
  */
-template <typename T>
-int Vector<T>::disordered() const
+template <typename T, typename Alloc>
+int Vector<T, Alloc>::disordered() const
 {
-    int n = 0;
-    for (int i = 1; i < _size; i++)
-        if (_elem[i - 1] > _elem[i])
-            n++;
-    return n; // 返回逆序数,若有序泽则   n = 0
+    return simdDisordered(_elem, _size); // 返回逆序数,若有序泽则   n = 0
 }
 
 // 查找
 
 /*-------------------------------------------------------
- * 函数名称：binSearch(T*A, T const& e, Rank lo, Rank hi)
- * 函数功能：二分查找
+ * 函数名称：binLowerBound(T const* A, T const& e, Rank lo, Rank hi)
+ * 函数功能：无分支二分查找，返回有序区间A[lo,hi)中首个不小于e的秩（无则为hi）
+ * 每步只比较一次、以条件传送收缩区间，不会分支预测失败；
+ * 同时预取下一步两个可能的中点，掩盖访存延迟
  */
 template <typename T>
-static Rank binSearch(T *A, T const &e, Rank lo, Rank hi) // 向量 A，查找元素e， 区间 [lo,hi）
+static Rank binLowerBound(T const *A, T const &e, Rank lo, Rank hi)
 {
-    
-    while (lo < hi)
+    Rank n = hi - lo;
+    if (n <= 0)
+        return lo;
+    T const *base = A + lo;
+    while (n > 1)
     {
-        Rank mi = (lo + hi) >> 1;
-        if (e < A[mi])
-        {
-            hi = mi;
-        }
-        else if (A[mi] < e)
-        {
-            lo = mi + 1;
-        }
-        else
-            return mi;
+        Rank half = n >> 1;
+#if defined(__GNUC__)
+        __builtin_prefetch(base + (half >> 1));
+        __builtin_prefetch(base + half + (half >> 1));
+#endif
+        base = (base[half] < e) ? base + half : base; // 条件传送
+        n -= half;
     }
-
-    return -1;
+    return (Rank)(base - A) + (*base < e);
+}
+
+/*-------------------------------------------------------
+ * 函数名称：binUpperBound(T const* A, T const& e, Rank lo, Rank hi)
+ * 函数功能：无分支二分查找，返回有序区间A[lo,hi)中首个大于e的秩（无则为hi）
+ */
+template <typename T>
+static Rank binUpperBound(T const *A, T const &e, Rank lo, Rank hi)
+{
+    Rank n = hi - lo;
+    if (n <= 0)
+        return lo;
+    T const *base = A + lo;
+    while (n > 1)
+    {
+        Rank half = n >> 1;
+#if defined(__GNUC__)
+        __builtin_prefetch(base + (half >> 1));
+        __builtin_prefetch(base + half + (half >> 1));
+#endif
+        base = (e < base[half]) ? base : base + half; // 条件传送
+        n -= half;
+    }
+    return (Rank)(base - A) + !(e < *base);
 }
 
 /**
@@ -395,15 +1203,154 @@ static Rank binSearch(T *A, T const &e, Rank lo, Rank hi) // 向量 A，查找
  * @param T const& e 待查找元素
  * @param Rank lo 起始位置
  * @param Rank hi 结束位置
- * @return 返回二分查找
- * @note 
+ * @return 命中时返回首个等于e的秩，否则返回-1
+ * @note 基于无分支的 lowerBound
 **/
-template<typename T> Rank Vector<T>::search(T const& e,Rank lo,Rank hi) const {
-    return binSearch(_elem,e,lo,hi);
+template<typename T, typename Alloc> Rank Vector<T, Alloc>::search(T const& e,Rank lo,Rank hi) const {
+    Rank r = binLowerBound(_elem, e, lo, hi);
+    return (r < hi && !(e < _elem[r])) ? r : -1;
 } 
 
+/**
+ * ----------------------------------------------------------
+ * @name lowerBound(T const& e, Rank lo, Rank hi) / upperBound(T const& e, Rank lo, Rank hi)
+ * @brief 有序区间的下界/上界查找
+ * @return lowerBound：首个不小于e的秩；upperBound：首个大于e的秩；均不存在时返回hi
+ * @note [lowerBound, upperBound)即等于e的全部元素
+**/
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::lowerBound(T const &e, Rank lo, Rank hi) const
+{
+    return binLowerBound(_elem, e, lo, hi);
+}
+
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::upperBound(T const &e, Rank lo, Rank hi) const
+{
+    return binUpperBound(_elem, e, lo, hi);
+}
+
+
+
+
+/**
+ * ----------------------------------------------------------
+ * @name range(T const& loKey, T const& hiKey) const
+ * @brief 有序向量的区间查询
+ * @return 所有满足 loKey <= e < hiKey 的元素构成的视图
+ * @note 两次二分定出上下界，O(logn)；返回视图而非副本，不申请空间
+**/
+template <typename T, typename Alloc>
+VectorView<T> Vector<T, Alloc>::range(T const &loKey, T const &hiKey) const
+{
+    Rank lo = binLowerBound(_elem, loKey, 0, _size);
+    Rank hi = binLowerBound(_elem, hiKey, lo, _size);
+    return VectorView<T>(_elem + lo, _elem + hi);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name range(K const& loKey, K const& hiKey, KeyFn key) const
+ * @brief 有序向量的按键区间查询（如按复数的模查询）
+ * @param KeyFn key 取键函数，须与向量的次序一致：a < b 时 key(a) <= key(b)
+ * @return 所有满足 loKey <= key(e) < hiKey 的元素构成的视图
+**/
+template <typename T, typename Alloc>
+template <typename K, typename KeyFn>
+VectorView<T> Vector<T, Alloc>::range(K const &loKey, K const &hiKey, KeyFn key) const
+{
+    auto lowerBoundBy = [&](K const &k, Rank lo) { // 首个 key(e) >= k 的秩
+        for (Rank n = _size - lo; n > 0;)
+        {
+            Rank half = n >> 1;
+            if (key(_elem[lo + half]) < k)
+                lo += half + 1, n -= half + 1;
+            else
+                n = half;
+        }
+        return lo;
+    };
+    Rank lo = lowerBoundBy(loKey, 0);
+    Rank hi = lowerBoundBy(hiKey, lo);
+    return VectorView<T>(_elem + lo, _elem + hi);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name searchBatch(T const* keys, Rank n, Rank* out) const
+ * @brief 有序向量的批量查找
+ * @param T const* keys 待查找的n个元素
+ * @param Rank n
+ * @param Rank* out 结果，out[i]与search(keys[i])相同：命中为首个相等元素的秩，否则为-1
+ * @note 1. keys无序时，每BATCH_LANES个键一组同步二分：各路区间长度相同，逐层一起前进，
+ *          每层先为各路发出预取，再做比较，多路访存重叠（存储级并行）
+ *       2. keys有序时，改为归并式的倍增（galloping）查找：从上一个键的结果出发，
+ *          步长倍增越过小于键者，再在最后一步内二分，相邻键相近时几乎是顺序扫描
+**/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::searchBatch(T const *keys, Rank n, Rank *out) const
+{
+    bool sorted = true;
+    for (Rank i = 1; i < n && sorted; i++)
+        sorted = !(keys[i] < keys[i - 1]);
 
+    if (sorted)
+    { // 倍增查找，pos单调不减
+        Rank pos = 0;
+        for (Rank i = 0; i < n; i++)
+        {
+            T const &e = keys[i];
+            if (pos < _size && _elem[pos] < e)
+            {
+                Rank lo = pos; // _elem[lo] < e
+                long long step = 1; // 与剩余长度比较而不求 lo + step，倍增也不会溢出
+                while (step < _size - lo && _elem[lo + step] < e)
+                {
+                    lo += (Rank)step;
+                    step <<= 1;
+                }
+                Rank hi = step < _size - lo ? lo + (Rank)step : _size;
+                pos = binLowerBound(_elem, e, lo + 1, hi);
+            }
+            out[i] = (pos < _size && !(e < _elem[pos])) ? pos : -1;
+        }
+        return;
+    }
 
+    T const *base[BATCH_LANES];
+    for (Rank b = 0; b < n; b += BATCH_LANES)
+    { // 多路同步二分
+        int lanes = n - b < BATCH_LANES ? n - b : BATCH_LANES;
+        T const *key = keys + b;
+        if (_size <= 0)
+        {
+            for (int j = 0; j < lanes; j++)
+                out[b + j] = -1;
+            continue;
+        }
+        for (int j = 0; j < lanes; j++)
+            base[j] = _elem;
+        for (Rank m = _size; m > 1;)
+        {
+            Rank half = m >> 1;
+#if defined(__GNUC__)
+            for (int j = 0; j < lanes; j++)
+            { // 先为各路预取下一层的两个候选中点
+                __builtin_prefetch(base[j] + (half >> 1));
+                __builtin_prefetch(base[j] + half + (half >> 1));
+            }
+#endif
+            for (int j = 0; j < lanes; j++)
+                base[j] = (base[j][half] < key[j]) ? base[j] + half : base[j]; // 条件传送
+            m -= half;
+        }
+        for (int j = 0; j < lanes; j++)
+        {
+            Rank r = (Rank)(base[j] - _elem) + (*base[j] < key[j]);
+            out[b + j] = (r < _size && !(key[j] < _elem[r])) ? r : -1;
+        }
+    }
+}
 
 /**
  * ----------------------------------------------------------
@@ -411,13 +1358,18 @@ template<typename T> Rank Vector<T>::search(T const& e,Rank lo,Rank hi) const {
  * @brief 排序整合接口
  * @param Rank lo
  * @param Rank hi
- * @param int ID 选取排序算法：1：冒泡排序；2：选择排序；3：归并排序；4：堆排序；5（默认）：快速排序
- * @note
+ * @param int ID 选取排序算法：1：冒泡排序；2：选择排序；3：归并排序；4：堆排序；5：基数排序；6：并行排序；
+ *               7：自然归并排序（有序、逆序、基本有序的输入接近线性时间）；
+ *               其他（默认）：整型/浮点元素用基数排序，其余用快速排序
+ * @note 1. 默认的快速排序实为内省排序（introsort），最坏情况 O(nlogn)
+ *       2. 稳定（相等元素不改变相对次序）：1、3、7；5对整数稳定；
+ *          不稳定：4、6（小规模转快速排序，超大规模为样本排序）及默认；
+ *          需要稳定性时直接调用 stableSort()
  **/
-template <typename T>
-void Vector<T>::sort(Rank lo, Rank hi, int ID)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::sort(Rank lo, Rank hi, int ID)
 {
-
+    VECTOR_PERF_SCOPE("sort");
     switch (ID)
     {
     case 1:
@@ -428,12 +1380,50 @@ void Vector<T>::sort(Rank lo, Rank hi, int ID)
     
         mergeSort(lo, hi);
         break;
-    // case 4: heapSort(lo, hi);break;
+    case 4:
+        heapSort(lo, hi);
+        break;
+    case 5:
+        radixSort(lo, hi);
+        break;
+    case 6:
+        parallelSort(lo, hi);
+        break;
+    case 7:
+        naturalMergeSort(lo, hi);
+        break;
     default:
-        break; // quickSort(lo,hi);
+        if constexpr (RadixTraits<T>::enabled)
+        {
+            if (hi - lo >= RADIX_CUTOFF)
+            { // 整型、浮点元素，规模较大时基数排序更快
+                radixSort(lo, hi);
+                break;
+            }
+        }
+        quickSort(lo, hi);
+        break;
     }
 }
 
+/**
+ * ----------------------------------------------------------
+ * @name stableSort(Rank lo, Rank hi)
+ * @brief 稳定排序：按 operator< 排序，相等元素保持原有的相对次序
+ * @note 1. 整数元素、规模不小于 RADIX_CUTOFF 时用基数排序（逐字节稳定分发；相等的整数无从区分）
+ *       2. 其余用自然归并排序：有序段直接利用，缓冲区至多 (hi-lo)/2 个元素且仅在需要合并时申请
+ *       3. 浮点数不走基数排序：-0.0 与 0.0 按 < 相等，而基数排序会把 -0.0 排在前面
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::stableSort(Rank lo, Rank hi)
+{
+    VECTOR_PERF_SCOPE("stableSort");
+    if (std::is_integral<T>::value && hi - lo >= RADIX_CUTOFF)
+        radixSort(lo, hi);
+    else
+        naturalMergeSort(lo, hi);
+}
+
 /**
  * ----------------------------------------------------------
  * @name bubbleSort(Rank lo, Rank hi)
@@ -442,22 +1432,24 @@ void Vector<T>::sort(Rank lo, Rank hi, int ID)
  * @param Rank hi
  * @note 内核bubble()使用了快停（一次遍历未冒泡，说明整体有序）
  **/
-template <typename T>
-void Vector<T>::bubbleSort(Rank lo, Rank hi)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::bubbleSort(Rank lo, Rank hi)
 {
     while (!bubble(lo, hi--));
 } // 从前往后进行起泡交换
 
-template <typename T>
-bool Vector<T>::bubble(Rank lo, Rank hi)
+template <typename T, typename Alloc>
+bool Vector<T, Alloc>::bubble(Rank lo, Rank hi)
 {
     bool sorted = true;
+    PerfTally tally;
     while (++lo < hi)
     {
-        if (_elem[lo - 1] > _elem[lo])
+        if (tally.less(_elem[lo], _elem[lo - 1]))
         {
             sorted = 0;
             swap(_elem[lo - 1], _elem[lo]);
+            tally.move(3);
         }
     }
     return sorted; // 若有序，触发快停
@@ -469,11 +1461,31 @@ bool Vector<T>::bubble(Rank lo, Rank hi)
  * @brief 归并排序
  * @param Rank lo
  * @param Rank hi
- * @note
+ * @note 整个排序只申请一次缓冲区：各层合并时前子向量至多 (hi-lo)/2 个元素
  **/
 
-template <typename T>
-void Vector<T>::mergeSort(Rank lo, Rank hi) //[lo,hi)
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::mergeSort(Rank lo, Rank hi) //[lo,hi)
+{
+    if (hi - lo < 2)
+        return;
+    Rank lb = (hi - lo) >> 1;
+    T *B = allocateBuffer(lb); // 全程共用的暂存空间
+    mergeSort(lo, hi, B);
+    deallocateBuffer(B, lb);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name mergeSort(Rank lo, Rank hi, T* B)
+ * @brief 归并排序（调用者提供缓冲区）
+ * @param Rank lo
+ * @param Rank hi
+ * @param T* B 缓冲区，至少容纳 (hi-lo)/2 个元素
+ * @note 两个子向量已然有序（_elem[mi-1] <= _elem[mi]）时跳过合并
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::mergeSort(Rank lo, Rank hi, T *B) //[lo,hi)
 {
     if (hi - lo < 2)
     {
@@ -481,9 +1493,10 @@ void Vector<T>::mergeSort(Rank lo, Rank hi) //[lo,hi)
     } // 递归到了最小单元
     int mi = (hi + lo) >> 1; // 对分
 
-    mergeSort(lo, mi); //[lo,mi) 递归
-    mergeSort(mi, hi);
-    merge(lo, mi, hi); // 合并
+    mergeSort(lo, mi, B); //[lo,mi) 递归
+    mergeSort(mi, hi, B);
+    if (_elem[mi] < _elem[mi - 1])
+        merge(lo, mi, hi, B); // 合并
 }
 
 // template <typename T>
@@ -507,26 +1520,745 @@ void Vector<T>::mergeSort(Rank lo, Rank hi) //[lo,hi)
 //     }
 // }
 
-template <typename T>
-void Vector<T>::merge(Rank lo, Rank mi, Rank hi) {
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::merge(Rank lo, Rank mi, Rank hi, T* B) {
     T* A = _elem + lo;
     int lb = mi - lo;
-    T* B = new T[lb];
-    for (Rank i = 0; i < lb; i++) B[i] = A[i]; // 复制前子向量
+    for (Rank i = 0; i < lb; i++) B[i] = A[i]; // 复制前子向量至缓冲区
     
     int lc = hi - mi;
     T* C = _elem + mi; // 后子向量C[0, lc)就地
     
-    for (Rank i = 0, j = 0, k = 0; j < lb; ) { // 归并：反复从B和C中取出更小者
-        if (k >= lc || B[j] < C[k]) A[i++] = B[j++];
+    PerfTally tally;
+    Rank i = 0, j = 0, k = 0;
+    while (j < lb) { // 归并：反复从B和C中取出更小者，相等时取B（前子向量）以保证稳定
+        if (k >= lc || !tally.less(C[k], B[j])) A[i++] = B[j++];
         else A[i++] = C[k++];
     }
-    
-    delete [] B; // 释放临时空间B
+    tally.move(lb + i); // 复制进缓冲区lb次，写回i次（后子向量余下者已在原处）
 }
 
 
+/*-------------------------------------------------------
+ * 函数名称：gallopFirst(T const* a, Rank n, P pred, bool fromEnd)
+ * 函数功能：跳跃查找：pred在a[0,n)上形如 假…假真…真，返回首个为真者的秩（全假为n）
+ *          自首端（fromEnd时自末端）以 1,3,7,15,... 的步长试探，再在最后一段内二分，
+ *          答案距起点d时只需 O(log d) 次比较
+ */
+template <typename T, typename P>
+static Rank gallopFirst(T const *a, Rank n, P pred, bool fromEnd)
+{
+    Rank lo, hi; // 答案在[lo,hi]中
+    if (!fromEnd)
+    {
+        Rank prev = -1, ofs = 0; // a[prev]为假，a[ofs]待试探
+        while (ofs < n && !pred(a[ofs]))
+            prev = ofs, ofs = 2 * ofs + 1;
+        lo = prev + 1, hi = ofs < n ? ofs : n;
+    }
+    else
+    {
+        Rank prev = n, d = 0; // a[prev]为真，试探a[n-1-d]
+        while (d < n && pred(a[n - 1 - d]))
+            prev = n - 1 - d, d = 2 * d + 1;
+        lo = d < n ? n - d : 0, hi = prev;
+    }
+    while (lo < hi)
+    {
+        Rank mi = lo + ((hi - lo) >> 1);
+        if (pred(a[mi]))
+            hi = mi;
+        else
+            lo = mi + 1;
+    }
+    return lo;
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name nextRun(Rank lo, Rank hi)
+ * @brief 识别自lo起的自然顺序段
+ * @return 段尾（[lo,返回值)已有序）
+ * @note 1. 严格递减的段就地翻转为递增；只翻转严格递减段，相等元素的相对次序不变
+ *       2. 段长不足 MIN_RUN 时以二分插入扩展到 MIN_RUN：插入位置取上界，稳定
+ **/
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::nextRun(Rank lo, Rank hi)
+{
+    Rank e = lo + 1;
+    if (e >= hi)
+        return hi;
+    PerfTally tally;
+    if (tally.less(_elem[e], _elem[lo]))
+    { // 严格递减段
+        while (e + 1 < hi && tally.less(_elem[e + 1], _elem[e]))
+            e++;
+        e++;
+        for (Rank i = lo, j = e - 1; i < j; i++, j--)
+            swap(_elem[i], _elem[j]);
+        tally.move(3 * ((e - lo) / 2));
+    }
+    else
+    { // 非降段
+        while (e + 1 < hi && !tally.less(_elem[e + 1], _elem[e]))
+            e++;
+        e++;
+    }
+    Rank end = (hi - lo < MIN_RUN) ? hi : lo + MIN_RUN;
+    for (; e < end; e++)
+    { // 二分插入_elem[e]
+        T x = std::move(_elem[e]);
+        Rank r = lo + gallopFirst(_elem + lo, e - lo, [&](T const &y) { return tally.less(x, y); }, true);
+        for (Rank i = e; i > r; i--)
+            _elem[i] = std::move(_elem[i - 1]);
+        _elem[r] = std::move(x);
+        tally.move(e - r + 2);
+    }
+    return e;
+}
 
+/**
+ * ----------------------------------------------------------
+ * @name mergeRuns(Rank lo, Rank mi, Rank hi, T* B)
+ * @brief 合并有序段[lo,mi)与[mi,hi)，稳定
+ * @param T* B 缓冲区，至少容纳两段中较短者
+ * @note 1. 先以跳跃查找剪掉已就位的两端：前段中不大于_elem[mi]者、后段中不小于_elem[mi-1]者
+ *       2. 较短的一段复制进B：前段短则自前向后合并，后段短则自后向前合并
+ *       3. 合并中某一侧连胜 MIN_GALLOP 次后，跳跃查找该侧连续获胜的整段，整段搬移
+ *       4. 相等时总取前段元素，故稳定
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::mergeRuns(Rank lo, Rank mi, Rank hi, T *B)
+{
+    PerfTally tally;
+    lo += gallopFirst(_elem + lo, mi - lo, [&](T const &x) { return tally.less(_elem[mi], x); }, false);
+    if (lo == mi)
+        return; // 两段本已有序
+    hi = mi + gallopFirst(_elem + mi, hi - mi, [&](T const &x) { return !tally.less(x, _elem[mi - 1]); }, true);
+    T *A = _elem + lo;
+    Rank lb = mi - lo, lc = hi - mi;
+    int winL = 0, winR = 0; // 两侧的连胜次数
+    if (lb <= lc)
+    { // 前段复制进B，自前向后合并
+        for (Rank i = 0; i < lb; i++)
+            B[i] = std::move(A[i]);
+        T *C = _elem + mi; // 后段C[0,lc)就地
+        Rank i = 0, j = 0, k = 0;
+        while (j < lb && k < lc)
+        {
+            if (tally.less(C[k], B[j]))
+            {
+                A[i++] = std::move(C[k++]);
+                winL = 0;
+                if (++winR >= MIN_GALLOP)
+                { // 后段中小于B[j]者整段搬移
+                    Rank m = gallopFirst(C + k, lc - k, [&](T const &x) { return !tally.less(x, B[j]); }, false);
+                    for (; m > 0; m--)
+                        A[i++] = std::move(C[k++]);
+                    winR = 0;
+                }
+            }
+            else
+            {
+                A[i++] = std::move(B[j++]);
+                winR = 0;
+                if (++winL >= MIN_GALLOP && j < lb)
+                { // B中不大于C[k]者整段搬移
+                    Rank m = gallopFirst(B + j, lb - j, [&](T const &x) { return tally.less(C[k], x); }, false);
+                    for (; m > 0; m--)
+                        A[i++] = std::move(B[j++]);
+                    winL = 0;
+                }
+            }
+        }
+        while (j < lb) // 后段剩余者已在原处
+            A[i++] = std::move(B[j++]);
+        tally.move(lb + i);
+    }
+    else
+    { // 后段复制进B，自后向前合并
+        for (Rank k = 0; k < lc; k++)
+            B[k] = std::move(_elem[mi + k]);
+        Rank i = lb + lc, j = lb, k = lc; // 前段A[0,j)就地，依次确定A[i-1]
+        while (j > 0 && k > 0)
+        {
+            if (tally.less(B[k - 1], A[j - 1]))
+            {
+                A[--i] = std::move(A[--j]);
+                winR = 0;
+                if (++winL >= MIN_GALLOP && j > 0)
+                { // 前段中大于B[k-1]者整段搬移
+                    Rank f = gallopFirst(A, j, [&](T const &x) { return tally.less(B[k - 1], x); }, true);
+                    while (j > f)
+                        A[--i] = std::move(A[--j]);
+                    winL = 0;
+                }
+            }
+            else
+            {
+                A[--i] = std::move(B[--k]);
+                winL = 0;
+                if (++winR >= MIN_GALLOP && k > 0)
+                { // B中不小于A[j-1]者整段搬移
+                    Rank f = gallopFirst(B, k, [&](T const &x) { return !tally.less(x, A[j - 1]); }, true);
+                    while (k > f)
+                        A[--i] = std::move(B[--k]);
+                    winR = 0;
+                }
+            }
+        }
+        while (k > 0) // 前段剩余者已在原处
+            A[--i] = std::move(B[--k]);
+        tally.move(lc + (lb + lc - i));
+    }
+}
+
+/*-------------------------------------------------------
+ * 函数名称：runPower(s1, n1, n2, n)
+ * 函数功能：powersort 中相邻两段[s1,s1+n1)、[s1+n1,s1+n1+n2)之间边界的“深度”：
+ *          两段中点在[0,n)上归一化后，二进制表示首个不同位的位置
+ */
+static int runPower(long long s1, long long n1, long long n2, long long n)
+{
+    int power = 0;
+    long long a = 2 * s1 + n1, b = a + n1 + n2; // 两段中点的2倍
+    for (;;)
+    {
+        ++power;
+        if (a >= n)
+            a -= n, b -= n; // 该位两者均为1
+        else if (b >= n)
+            break; // 该位不同
+        a <<= 1, b <<= 1;
+    }
+    return power;
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name naturalMergeSort(Rank lo, Rank hi)
+ * @brief 自然归并排序（powersort，Munro & Wild）
+ * @param Rank lo
+ * @param Rank hi
+ * @note 1. 自左向右识别顺序段（逆序段翻转），每两段之间的边界算出深度；
+ *          栈中段边界深度递增，新边界深度更小时先合并栈顶，合并次序近似最优
+ *       2. 已有序、逆序的输入只有一段，n-1 次比较即完成，不申请缓冲区
+ *       3. 合并见 mergeRuns：两端剪枝 + 跳跃合并，稳定
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::naturalMergeSort(Rank lo, Rank hi)
+{
+    Rank n = hi - lo;
+    if (n < 2)
+        return;
+    T *B = nullptr; // 缓冲区，首次合并时才申请
+    Rank stackStart[64];
+    int stackPower[64], top = 0; // 栈中各段的起点，及其与下一段之间边界的深度
+    Rank s1 = lo, e1 = nextRun(lo, hi);
+    while (e1 < hi)
+    {
+        Rank e2 = nextRun(e1, hi);
+        int p = runPower(s1 - lo, e1 - s1, e2 - e1, n);
+        while (top > 0 && stackPower[top - 1] > p)
+        { // 栈顶边界更深，先行合并
+            Rank s0 = stackStart[--top];
+            if (!B)
+                B = allocateBuffer(n / 2);
+            mergeRuns(s0, s1, e1, B);
+            s1 = s0;
+        }
+        stackStart[top] = s1, stackPower[top++] = p;
+        s1 = e1, e1 = e2;
+    }
+    while (top > 0)
+    { // 自右向左合并余下各段
+        Rank s0 = stackStart[--top];
+        if (!B)
+            B = allocateBuffer(n / 2);
+        mergeRuns(s0, s1, hi, B);
+        s1 = s0;
+    }
+    if (B)
+        deallocateBuffer(B, n / 2);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name insertionSort(Rank lo, Rank hi)
+ * @brief 插入排序
+ * @param Rank lo
+ * @param Rank hi
+ * @note 仅用于小区间收尾；严格小于才后移，故稳定
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::insertionSort(Rank lo, Rank hi)
+{
+    PerfTally tally;
+    for (Rank i = lo + 1; i < hi; i++)
+    {
+        T e = _elem[i];
+        Rank j = i;
+        for (; lo < j && tally.less(e, _elem[j - 1]); j--)
+            _elem[j] = _elem[j - 1]; // 比e大的元素逐个后移
+        _elem[j] = e;
+        tally.move(i - j + 2);
+    }
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name median3(Rank a, Rank b, Rank c)
+ * @brief 三者取中
+ * @return 三个秩中，所指元素居中者的秩
+ **/
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::median3(Rank a, Rank b, Rank c) const
+{
+    PerfTally tally;
+    if (tally.less(_elem[a], _elem[b]))
+        return tally.less(_elem[b], _elem[c]) ? b : (tally.less(_elem[a], _elem[c]) ? c : a);
+    else
+        return tally.less(_elem[a], _elem[c]) ? a : (tally.less(_elem[b], _elem[c]) ? c : b);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name partition(Rank lo, Rank hi)
+ * @brief 轴点构造，区间[lo,hi)
+ * @return 轴点的秩 mi：[lo,mi)均不大于轴点，(mi,hi)均不小于轴点
+ * @note 小区间三者取中，大区间九数取中（ninther）；
+ *       双向扫描遇到与轴点相等者即停下交换，大量重复元素时也能均匀切分
+ **/
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::partition(Rank lo, Rank hi)
+{
+    Rank n = hi - lo, mi = lo + (n >> 1), last = hi - 1;
+    Rank p;
+    if (n > NINTHER_CUTOFF)
+    { // 九数取中：三组三者取中，再取中
+        Rank d = n >> 3;
+        p = median3(median3(lo, lo + d, lo + 2 * d),
+                    median3(mi - d, mi, mi + d),
+                    median3(last - 2 * d, last - d, last));
+    }
+    else
+        p = median3(lo, mi, last);
+    swap(_elem[lo], _elem[p]); // 轴点就位于首元素
+    T pivot = _elem[lo];
+    PerfTally tally;
+    tally.move(4);
+
+    Rank i = lo, j = hi;
+    while (true)
+    {
+        while (tally.less(_elem[++i], pivot)) // 自左向右，越过小于轴点者
+            if (i == last)
+                break;
+        while (tally.less(pivot, _elem[--j])) // 自右向左，越过大于轴点者（_elem[lo]为哨兵）
+            ;
+        if (i >= j)
+            break;
+        swap(_elem[i], _elem[j]);
+        tally.move(3);
+    }
+    swap(_elem[lo], _elem[j]); // 轴点归位
+    tally.move(3);
+    return j;
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name quickSort(Rank lo, Rank hi)
+ * @brief 快速排序（内省排序）
+ * @param Rank lo
+ * @param Rank hi
+ * @note 递归深度上限 2·log2(n)，超出即转堆排序，保证最坏 O(nlogn)
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::quickSort(Rank lo, Rank hi)
+{
+    int depthLimit = 0;
+    for (Rank n = hi - lo; n > 1; n >>= 1)
+        depthLimit += 2; // 2·floor(log2 n)
+    introSort(lo, hi, depthLimit);
+}
+
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::introSort(Rank lo, Rank hi, int depthLimit)
+{
+    while (hi - lo > INSERTION_CUTOFF)
+    {
+        if (depthLimit-- == 0)
+        { // 切分持续失衡，转堆排序
+            heapSort(lo, hi);
+            return;
+        }
+        Rank mi = partition(lo, hi);
+        if (mi - lo < hi - mi - 1)
+        { // 递归处理较短一侧，较长一侧就地迭代，栈深不超过 O(logn)
+            introSort(lo, mi, depthLimit);
+            lo = mi + 1;
+        }
+        else
+        {
+            introSort(mi + 1, hi, depthLimit);
+            hi = mi;
+        }
+    }
+    insertionSort(lo, hi); // 小区间收尾
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name heapSort(Rank lo, Rank hi)
+ * @brief 堆排序
+ * @param Rank lo
+ * @param Rank hi
+ * @note 就地建大顶堆（Floyd 自下而上），再反复将堆顶换至末尾
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::percolateDown(Rank lo, Rank n, Rank i)
+{
+    T* H = _elem + lo;
+    T e = H[i];
+    PerfTally tally;
+    tally.move(2);
+    for (Rank c; (c = 2 * i + 1) < n; i = c)
+    {
+        if (c + 1 < n && tally.less(H[c], H[c + 1]))
+            c++; // 取较大的孩子
+        if (!tally.less(e, H[c]))
+            break;
+        H[i] = H[c]; // 孩子上移
+        tally.move(1);
+    }
+    H[i] = e;
+}
+
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::heapSort(Rank lo, Rank hi)
+{
+    Rank n = hi - lo;
+    PerfTally tally;
+    for (Rank i = n / 2 - 1; 0 <= i; i--)
+        percolateDown(lo, n, i); // 建堆
+    while (1 < n)
+    {
+        swap(_elem[lo], _elem[lo + --n]); // 堆顶（最大者）归位
+        tally.move(3);
+        percolateDown(lo, n, 0);
+    }
+}
+
+
+
+/**
+ * ----------------------------------------------------------
+ * @name parallelSort(Rank lo, Rank hi, int threads)
+ * @brief 多线程排序接口
+ * @param Rank lo
+ * @param Rank hi
+ * @param int threads 线程数，0表示取硬件线程数；多于 PARALLEL_MAX_THREADS 者按其计
+ * @note 小区间直接快排；大区间并行归并排序；超大区间用样本排序
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::parallelSort(Rank lo, Rank hi, int threads)
+{
+    if (threads <= 0)
+        threads = hardwareThreads();
+    if (threads > PARALLEL_MAX_THREADS)
+        threads = PARALLEL_MAX_THREADS; // 每个线程都是新开的，不能任由调用者指定
+    Rank n = hi - lo;
+    if (threads == 1 || n < PARALLEL_CUTOFF)
+    {
+        quickSort(lo, hi);
+        return;
+    }
+    if (n >= SAMPLESORT_CUTOFF)
+    {
+        sampleSort(lo, hi, threads);
+        return;
+    }
+    T *W = allocateBuffer(n); // 归并用的整块缓冲区
+    parallelMergeSort(lo, hi, W, threads);
+    deallocateBuffer(W, n);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name parallelMergeSort(Rank lo, Rank hi, T* W, int threads)
+ * @brief 并行归并排序
+ * @param T* W 缓冲区，对应[lo,hi)，容纳 hi-lo 个元素
+ * @note 两半各分一半线程递归（fork-join），再并行归并；线程用尽后退化为串行归并排序
+ *       故分叉深度为 ceil(log2(threads))，同时存在的线程不超过 threads（parallelSort 中已截至 PARALLEL_MAX_THREADS）
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::parallelMergeSort(Rank lo, Rank hi, T *W, int threads)
+{
+    if (threads <= 1 || hi - lo < PARALLEL_CUTOFF)
+    {
+        mergeSort(lo, hi, W);
+        return;
+    }
+    Rank mi = (lo + hi) >> 1;
+    int tl = threads >> 1;
+    parallelInvoke([=] { parallelMergeSort(lo, mi, W, tl); },
+                   [=] { parallelMergeSort(mi, hi, W + (mi - lo), threads - tl); });
+    PerfTally tally;
+    if (tally.less(_elem[mi], _elem[mi - 1]))
+        parallelMerge(lo, mi, hi, W, threads);
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name coRank(Rank k, Rank lo, Rank mi, Rank hi)
+ * @brief 协同秩：归并[lo,mi)与[mi,hi)时，结果前k个元素中有多少来自前者
+ * @note 二分查找；相等时前子向量优先，与串行归并一致
+ **/
+template <typename T, typename Alloc>
+Rank Vector<T, Alloc>::coRank(Rank k, Rank lo, Rank mi, Rank hi) const
+{
+    T *A = _elem + lo, *B = _elem + mi;
+    Rank la = mi - lo, lb = hi - mi;
+    Rank iLo = k > lb ? k - lb : 0, iHi = k < la ? k : la;
+    PerfTally tally;
+    while (iLo < iHi)
+    {
+        Rank i = (iLo + iHi) >> 1, j = k - i; // 试取前者i个、后者j个（j >= 1）
+        if (tally.less(B[j - 1], A[i]))
+            iHi = i; // 后者的B[j-1]应先于A[i]输出，i不能再多
+        else
+            iLo = i + 1; // A[i]应先于B[j-1]输出，i至少再加一
+    }
+    return iLo;
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name parallelMerge(Rank lo, Rank mi, Rank hi, T* W, int threads)
+ * @brief 并行二路归并
+ * @note 输出等分为threads段，各段用coRank定出输入的分界后独立归并至W，最后并行复制回原处
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::parallelMerge(Rank lo, Rank mi, Rank hi, T *W, int threads)
+{
+    long long n = hi - lo;
+    parallelFor(threads, [=](int t) {
+        Rank k0 = (Rank)(n * t / threads), k1 = (Rank)(n * (t + 1) / threads);
+        Rank i = lo + coRank(k0, lo, mi, hi), iEnd = lo + coRank(k1, lo, mi, hi);
+        Rank j = mi + (k0 - (i - lo)), jEnd = mi + (k1 - (iEnd - lo));
+        PerfTally tally;
+        for (Rank k = k0; k < k1;)
+            W[k++] = (j >= jEnd || (i < iEnd && !tally.less(_elem[j], _elem[i]))) ? _elem[i++] : _elem[j++];
+    });
+    PerfTally tally;
+    tally.move(2 * n);
+    parallelFor(threads, [=](int t) {
+        Rank k0 = (Rank)(n * t / threads), k1 = (Rank)(n * (t + 1) / threads);
+        for (Rank k = k0; k < k1; k++)
+            _elem[lo + k] = W[k];
+    });
+}
+
+/**
+ * ----------------------------------------------------------
+ * @name sampleSort(Rank lo, Rank hi, int threads)
+ * @brief 并行样本排序
+ * @param Rank lo
+ * @param Rank hi
+ * @param int threads
+ * @note 1. 随机取样并排序，等距选出 threads-1 个分界点，划定 threads 个桶
+ *       2. 与相邻分界点相等的分界点（重复分界点）另设一个“相等桶”，专收等于它的元素；
+ *          相等桶无需排序，故少数几种取值、全部相等的输入不会全部落进一个桶由单线程排序
+ *       3. 各线程统计自己那段中各桶的元素数，前缀和得到每段每桶的写入位置
+ *       4. 各线程将自己那段分发到缓冲区，并行取回，再各自快排一个普通桶
+ *       5. 计数数组经分配器（重绑定为Rank）申请，与其他缓冲区一致
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::sampleSort(Rank lo, Rank hi, int threads)
+{
+    long long n = hi - lo;
+    int p = threads;
+    Rank s = p * SAMPLESORT_OVERSAMPLE;
+    Vector<T, Alloc> S(_alloc, s);
+    unsigned long long x = 0x9E3779B97F4A7C15ull; // xorshift 取样
+    for (Rank i = 0; i < s; i++)
+    {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        S.push_Back(_elem[lo + (Rank)(x % n)]);
+    }
+    S.sort(0);
+    T *splitter = S._elem; // 分界点 splitter[0, p-1)
+    for (int b = 1; b < p; b++)
+        splitter[b - 1] = S._elem[b * SAMPLESORT_OVERSAMPLE];
+
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Rank> RankAlloc;
+    typedef std::allocator_traits<RankAlloc> RankTraits;
+    RankAlloc rankAlloc(_alloc);
+    int q = 2 * p - 1; // 桶2l：普通桶l；桶2l-1：等于splitter[l-1]的相等桶（仅重复分界点才用）
+    Rank *heavy = RankTraits::allocate(rankAlloc, p); // heavy[i]：splitter[i]是否为重复分界点
+    for (int i = 0; i + 1 < p; i++)
+        heavy[i] = (i > 0 && !(splitter[i - 1] < splitter[i])) || (i + 2 < p && !(splitter[i] < splitter[i + 1]));
+    auto bucketOf = [=](T const &e, PerfTally &tally) { // 不大于e的分界点数l；e等于重复分界点splitter[l-1]时归入相等桶
+        Rank l = 0, r = p - 1;
+        while (l < r)
+        {
+            Rank m = (l + r) >> 1;
+            if (tally.less(e, splitter[m]))
+                r = m;
+            else
+                l = m + 1;
+        }
+        return (l > 0 && heavy[l - 1] && !tally.less(splitter[l - 1], e)) ? 2 * l - 1 : 2 * l;
+    };
+
+    Rank *count = RankTraits::allocate(rankAlloc, p * q); // count[t*q+b]：第t段中属于桶b的元素数，随后改为写入位置
+    for (Rank i = 0; i < p * q; i++)
+        count[i] = 0;
+    parallelFor(p, [=](int t) {
+        PerfTally tally;
+        for (Rank i = lo + (Rank)(n * t / p), end = lo + (Rank)(n * (t + 1) / p); i < end; i++)
+            count[t * q + bucketOf(_elem[i], tally)]++;
+    });
+    Rank *bucket = RankTraits::allocate(rankAlloc, q + 1); // 桶b占缓冲区[bucket[b], bucket[b+1])
+    Rank sum = 0;
+    for (int b = 0; b < q; b++)
+    {
+        bucket[b] = sum;
+        for (int t = 0; t < p; t++)
+        {
+            Rank c = count[t * q + b];
+            count[t * q + b] = sum;
+            sum += c;
+        }
+    }
+    bucket[q] = sum;
+
+    T *W = allocateBuffer((Rank)n);
+    parallelFor(p, [=](int t) {
+        PerfTally tally;
+        Rank *pos = count + t * q;
+        for (Rank i = lo + (Rank)(n * t / p), end = lo + (Rank)(n * (t + 1) / p); i < end; i++)
+            W[pos[bucketOf(_elem[i], tally)]++] = _elem[i];
+    });
+    parallelFor(p, [=](int t) { // 按位置均分取回，不受桶大小不均的影响
+        for (Rank k = (Rank)(n * t / p), end = (Rank)(n * (t + 1) / p); k < end; k++)
+            _elem[lo + k] = W[k];
+    });
+    PerfTally tally;
+    tally.move(2 * n);
+    parallelFor(p, [=](int t) { // 线程t排序普通桶t，相等桶已就位
+        quickSort(lo + bucket[2 * t], lo + bucket[2 * t + 1]);
+    });
+    deallocateBuffer(W, (Rank)n);
+    RankTraits::deallocate(rankAlloc, bucket, q + 1);
+    RankTraits::deallocate(rankAlloc, count, p * q);
+    RankTraits::deallocate(rankAlloc, heavy, p);
+}
+
+
+
+/**
+ * ----------------------------------------------------------
+ * @name radixSort(Rank lo, Rank hi)
+ * @brief 基数排序（LSD，每趟一个字节）
+ * @param Rank lo
+ * @param Rank hi
+ * @note 1. 一趟扫描同时统计全部字节的直方图，后续各趟无需再计数
+ *       2. 某字节上所有键都相同（直方图只有一个非零桶）时跳过该趟
+ *       3. 两块空间交替分发，稳定；非整型/浮点元素转快速排序
+ **/
+template <typename T, typename Alloc>
+void Vector<T, Alloc>::radixSort(Rank lo, Rank hi)
+{
+    if constexpr (RadixTraits<T>::enabled)
+    {
+        typedef RadixTraits<T> RT;
+        const int W = sizeof(T);
+        Rank n = hi - lo;
+        if (n < 2)
+            return;
+        Rank count[W][256];
+        memset(count, 0, sizeof(count));
+        for (Rank i = lo; i < hi; i++)
+        { // 一趟统计所有字节的直方图
+            typename RT::U k = RT::key(_elem[i]);
+            for (int d = 0; d < W; d++)
+                count[d][(k >> (8 * d)) & 0xFF]++;
+        }
+
+        T *src = _elem + lo, *dst = allocateBuffer(n), *buffer = dst;
+        PerfTally tally;
+        for (int d = 0; d < W; d++)
+        {
+            Rank *c = count[d];
+            if (c[(RT::key(src[0]) >> (8 * d)) & 0xFF] == n)
+                continue; // 该字节全部相同，本趟不改变次序
+            for (Rank b = 0, sum = 0; b < 256; b++)
+            { // 前缀和，转为各桶起始位置
+                Rank t = c[b];
+                c[b] = sum;
+                sum += t;
+            }
+            for (Rank i = 0; i < n; i++)
+                dst[c[(RT::key(src[i]) >> (8 * d)) & 0xFF]++] = src[i];
+            tally.move(n);
+            swap(src, dst);
+        }
+        if (src != _elem + lo)
+        {
+            memcpy(_elem + lo, src, n * sizeof(T)); // 结果落在缓冲区，复制回来
+            tally.move(n);
+        }
+        deallocateBuffer(buffer, n);
+    }
+    else
+        quickSort(lo, hi);
+}
+
+
+
+/**
+ * ----------------------------------------------------------
+ * @name sortByKey(Rank lo, Rank hi, KeyFn key)
+ * @brief 按键排序
+ * @param Rank lo
+ * @param Rank hi
+ * @param KeyFn key 取键函数，key(e) 的序即排序依据（如复数取模的平方，免开方）
+ * @note 1. 每个元素只调用一次key，得到紧凑的（键，秩）数组，排序只搬动这些小记录
+ *       2. 再按排好的秩沿置换环就地搬动元素，每个元素只移动一次
+ *       3. 键相等者保持原有次序（稳定）
+ **/
+template <typename T, typename Alloc>
+template <typename KeyFn>
+void Vector<T, Alloc>::sortByKey(Rank lo, Rank hi, KeyFn key)
+{
+    typedef typename std::decay<decltype(key(_elem[lo]))>::type K;
+    Rank n = hi - lo;
+    if (n < 2)
+        return;
+    Vector<KeyRank<K>> pairs(n);
+    for (Rank i = 0; i < n; i++)
+        pairs.push_Back(KeyRank<K>{key(_elem[lo + i]), i});
+    pairs.sort(0);
+
+    KeyRank<K> *P = pairs.data(); // P[k].rank：排序后第k个元素原来的秩
+    for (Rank i = 0; i < n; i++)
+    {
+        if (P[i].rank == i)
+            continue; // 已就位，或所在的环已处理
+        T e = std::move(_elem[lo + i]);
+        Rank k = i, j;
+        while ((j = P[k].rank) != i)
+        { // 沿置换环逐个搬动（移动而非复制，重型元素不做深拷贝）
+            _elem[lo + k] = std::move(_elem[lo + j]);
+            P[k].rank = k;
+            k = j;
+        }
+        _elem[lo + k] = std::move(e);
+        P[k].rank = k;
+    }
+}
 
 
 #endif
\ No newline at end of file
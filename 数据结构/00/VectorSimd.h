@@ -0,0 +1,349 @@
+#ifndef _VECTOR_SIMD_H
+#define _VECTOR_SIMD_H
+
+#include <cstring>
+#include <type_traits>
+
+typedef int Rank; // 秩
+
+/*
+ * 算术类型元素的向量化扫描：无序查找、相邻逆序对计数、有序性判定
+ * x86 上按运行时检测到的指令集选用 AVX2（每条指令比较32字节）或 SSE4.2（16字节），
+ * 其余平台及不支持的类型走标量实现；各实现的结果与标量版本逐位一致
+ * （浮点数按 ==、> 的语义比较，NaN 与任何数都不相等、不构成逆序）
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define VECTOR_SIMD_X86 0
+#endif
+
+/*------------------------------------------------------
+结构名称：SimdEligible<T>
+结构功能：T 能否走向量化路径：1/2/4/8字节的整数（bool除外）或 float/double
+*/
+template <typename T>
+struct SimdEligible
+{
+    static const bool value =
+        (std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+         (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+        std::is_same<T, float>::value || std::is_same<T, double>::value;
+};
+
+/*------------------------------------------------------
+函数名称：simdLevel()
+函数功能：运行时检测到的指令集等级：2 = AVX2，1 = SSE4.2，0 = 仅标量；只检测一次
+*/
+static inline int simdLevel()
+{
+#if VECTOR_SIMD_X86
+    static const int level = __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("sse4.2") ? 1 : 0;
+    return level;
+#else
+    return 0;
+#endif
+}
+
+// 标量实现（兜底，也用于向量化后剩余的尾部）
+
+template <typename T>
+static Rank scalarFind(T const *A, T const &e, Rank lo, Rank hi)
+{
+    while ((lo < hi--) && (e != A[hi])); // 从hi末尾向前查找
+    return hi;                           // 失败时为lo-1
+}
+
+template <typename T>
+static int scalarDisordered(T const *A, Rank lo, Rank hi) // 统计(lo,hi)中A[i-1] > A[i]的i
+{
+    int n = 0;
+    for (Rank i = lo + 1; i < hi; i++)
+        if (A[i - 1] > A[i])
+            n++;
+    return n;
+}
+
+template <typename T>
+static bool scalarIsSorted(T const *A, Rank lo, Rank hi)
+{
+    for (Rank i = lo + 1; i < hi; i++)
+        if (A[i - 1] > A[i])
+            return false;
+    return true;
+}
+
+#if VECTOR_SIMD_X86
+
+/*
+ * 逐lane比较，结果统一为整数掩码向量（满足的lane各字节全1），
+ * 再以 movemask_epi8 取字节掩码：最高置位字节 / sizeof(T) 即最后一个命中的lane，
+ * 置位字节数 / sizeof(T) 即命中的lane数；各种元素宽度共用同一套扫描代码
+ * 无符号整数比较大小前先翻转符号位，转为有符号比较
+ */
+
+template <typename T>
+SIMD_TARGET_AVX2 static inline __m256i avx2Broadcast(T const &e)
+{
+    T lanes[32 / sizeof(T)];
+    for (size_t i = 0; i < 32 / sizeof(T); i++)
+        lanes[i] = e;
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lanes));
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static inline __m256i avx2Load(T const *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static inline __m256i avx2Eq(__m256i a, __m256i b)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    else if constexpr (sizeof(T) == 1)
+        return _mm256_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(T) == 2)
+        return _mm256_cmpeq_epi16(a, b);
+    else if constexpr (sizeof(T) == 4)
+        return _mm256_cmpeq_epi32(a, b);
+    else
+        return _mm256_cmpeq_epi64(a, b);
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static inline __m256i avx2Gt(__m256i a, __m256i b) // a > b
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_GT_OQ));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_GT_OQ));
+    else
+    {
+        if constexpr (std::is_unsigned<T>::value)
+        {
+            __m256i sign = avx2Broadcast<T>(T(T(1) << (8 * sizeof(T) - 1)));
+            a = _mm256_xor_si256(a, sign);
+            b = _mm256_xor_si256(b, sign);
+        }
+        if constexpr (sizeof(T) == 1)
+            return _mm256_cmpgt_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_cmpgt_epi16(a, b);
+        else if constexpr (sizeof(T) == 4)
+            return _mm256_cmpgt_epi32(a, b);
+        else
+            return _mm256_cmpgt_epi64(a, b);
+    }
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static Rank avx2Find(T const *A, T const &e, Rank lo, Rank hi)
+{
+    const Rank L = 32 / sizeof(T);
+    __m256i key = avx2Broadcast(e);
+    while (hi - lo >= L)
+    { // 自后向前，每次比较L个元素
+        hi -= L;
+        unsigned m = (unsigned)_mm256_movemask_epi8(avx2Eq<T>(avx2Load(A + hi), key));
+        if (m)
+            return hi + (31 - __builtin_clz(m)) / (Rank)sizeof(T);
+    }
+    return scalarFind(A, e, lo, hi);
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static int avx2Disordered(T const *A, Rank n)
+{
+    const Rank L = 32 / sizeof(T);
+    long long count = 0; // 命中的字节数
+    Rank i = 1;
+    for (; i + L <= n; i += L) // A[i-1, i+L-1)与A[i, i+L)逐lane比较
+        count += __builtin_popcount((unsigned)_mm256_movemask_epi8(avx2Gt<T>(avx2Load(A + i - 1), avx2Load(A + i))));
+    return (int)(count / sizeof(T)) + scalarDisordered(A, i - 1, n);
+}
+
+template <typename T>
+SIMD_TARGET_AVX2 static bool avx2IsSorted(T const *A, Rank n)
+{
+    const Rank L = 32 / sizeof(T);
+    Rank i = 1;
+    for (; i + 2 * L <= n; i += 2 * L)
+    { // 每次检查2L对，合并掩码后只判断一次
+        __m256i g0 = avx2Gt<T>(avx2Load(A + i - 1), avx2Load(A + i));
+        __m256i g1 = avx2Gt<T>(avx2Load(A + i + L - 1), avx2Load(A + i + L));
+        if (!_mm256_testz_si256(_mm256_or_si256(g0, g1), _mm256_or_si256(g0, g1)))
+            return false; // 发现逆序即返回
+    }
+    return scalarIsSorted(A, i - 1, n);
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static inline __m128i sseBroadcast(T const &e)
+{
+    T lanes[16 / sizeof(T)];
+    for (size_t i = 0; i < 16 / sizeof(T); i++)
+        lanes[i] = e;
+    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(lanes));
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static inline __m128i sseLoad(T const *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static inline __m128i sseEq(__m128i a, __m128i b)
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    else if constexpr (sizeof(T) == 1)
+        return _mm_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(T) == 2)
+        return _mm_cmpeq_epi16(a, b);
+    else if constexpr (sizeof(T) == 4)
+        return _mm_cmpeq_epi32(a, b);
+    else
+        return _mm_cmpeq_epi64(a, b);
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static inline __m128i sseGt(__m128i a, __m128i b) // a > b
+{
+    if constexpr (std::is_same<T, float>::value)
+        return _mm_castps_si128(_mm_cmpgt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+    else if constexpr (std::is_same<T, double>::value)
+        return _mm_castpd_si128(_mm_cmpgt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+    else
+    {
+        if constexpr (std::is_unsigned<T>::value)
+        {
+            __m128i sign = sseBroadcast<T>(T(T(1) << (8 * sizeof(T) - 1)));
+            a = _mm_xor_si128(a, sign);
+            b = _mm_xor_si128(b, sign);
+        }
+        if constexpr (sizeof(T) == 1)
+            return _mm_cmpgt_epi8(a, b);
+        else if constexpr (sizeof(T) == 2)
+            return _mm_cmpgt_epi16(a, b);
+        else if constexpr (sizeof(T) == 4)
+            return _mm_cmpgt_epi32(a, b);
+        else
+            return _mm_cmpgt_epi64(a, b);
+    }
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static Rank sseFind(T const *A, T const &e, Rank lo, Rank hi)
+{
+    const Rank L = 16 / sizeof(T);
+    __m128i key = sseBroadcast(e);
+    while (hi - lo >= L)
+    {
+        hi -= L;
+        unsigned m = (unsigned)_mm_movemask_epi8(sseEq<T>(sseLoad(A + hi), key));
+        if (m)
+            return hi + (31 - __builtin_clz(m)) / (Rank)sizeof(T);
+    }
+    return scalarFind(A, e, lo, hi);
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static int sseDisordered(T const *A, Rank n)
+{
+    const Rank L = 16 / sizeof(T);
+    long long count = 0; // 命中的字节数
+    Rank i = 1;
+    for (; i + L <= n; i += L)
+        count += __builtin_popcount((unsigned)_mm_movemask_epi8(sseGt<T>(sseLoad(A + i - 1), sseLoad(A + i))));
+    return (int)(count / sizeof(T)) + scalarDisordered(A, i - 1, n);
+}
+
+template <typename T>
+SIMD_TARGET_SSE42 static bool sseIsSorted(T const *A, Rank n)
+{
+    const Rank L = 16 / sizeof(T);
+    Rank i = 1;
+    for (; i + 2 * L <= n; i += 2 * L)
+    {
+        __m128i g = _mm_or_si128(sseGt<T>(sseLoad(A + i - 1), sseLoad(A + i)),
+                                 sseGt<T>(sseLoad(A + i + L - 1), sseLoad(A + i + L)));
+        if (!_mm_testz_si128(g, g))
+            return false;
+    }
+    return scalarIsSorted(A, i - 1, n);
+}
+
+#endif // VECTOR_SIMD_X86
+
+/*------------------------------------------------------
+函数名称：simdFind(T const* A, T const& e, Rank lo, Rank hi)
+函数功能：A[lo,hi)中最后一个等于e的秩，失败时返回lo-1（与顺序查找一致）
+*/
+template <typename T>
+static Rank simdFind(T const *A, T const &e, Rank lo, Rank hi)
+{
+#if VECTOR_SIMD_X86
+    if constexpr (SimdEligible<T>::value)
+    {
+        int level = simdLevel();
+        if (level == 2)
+            return avx2Find(A, e, lo, hi);
+        if (level == 1)
+            return sseFind(A, e, lo, hi);
+    }
+#endif
+    return scalarFind(A, e, lo, hi);
+}
+
+/*------------------------------------------------------
+函数名称：simdDisordered(T const* A, Rank n)
+函数功能：A[0,n)中相邻逆序对的总数
+*/
+template <typename T>
+static int simdDisordered(T const *A, Rank n)
+{
+#if VECTOR_SIMD_X86
+    if constexpr (SimdEligible<T>::value)
+    {
+        int level = simdLevel();
+        if (level == 2)
+            return avx2Disordered(A, n);
+        if (level == 1)
+            return sseDisordered(A, n);
+    }
+#endif
+    return scalarDisordered(A, 0, n);
+}
+
+/*------------------------------------------------------
+函数名称：simdIsSorted(T const* A, Rank n)
+函数功能：A[0,n)是否非降；遇到第一个逆序对即返回
+*/
+template <typename T>
+static bool simdIsSorted(T const *A, Rank n)
+{
+#if VECTOR_SIMD_X86
+    if constexpr (SimdEligible<T>::value)
+    {
+        int level = simdLevel();
+        if (level == 2)
+            return avx2IsSorted(A, n);
+        if (level == 1)
+            return sseIsSorted(A, n);
+    }
+#endif
+    return scalarIsSorted(A, 0, n);
+}
+
+#endif
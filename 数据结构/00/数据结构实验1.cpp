@@ -4,6 +4,7 @@
 #include <cmath>
 // 引入 Vector 模板类的实现文件
 #include "Vector.cpp"
+#include "ComplexVector.h"
 
 class Complex {
 public:
@@ -16,25 +17,49 @@ public:
         return std::sqrt(real * real + imag * imag);
     }
 
+    // 模的平方，比较大小时无需开方
+    double norm() const {
+        return real * real + imag * imag;
+    }
+
     bool operator==(const Complex& other) const {
         return real == other.real && imag == other.imag;
     }
 
+    bool operator!=(const Complex& other) const {
+        return !(*this == other);
+    }
+
     bool operator<(const Complex& other) const {
-        double mag1 = magnitude();
-        double mag2 = other.magnitude();
+        double mag1 = norm();
+        double mag2 = other.norm();
         if (mag1!= mag2) return mag1 < mag2;
         return real < other.real;
     }
+
+    bool operator>(const Complex& other) const {
+        return other < *this;
+    }
 };
 
-// 随机生成复数向量
-Vector<Complex> generateRandomComplexVector(int n) {
+// 复数的散列，供 Vector::deduplicate() 的散列去重使用（与 operator== 一致）
+namespace std {
+template <>
+struct hash<Complex> {
+    size_t operator()(const Complex& c) const {
+        size_t h = hash<double>()(c.real);
+        return h ^ (hash<double>()(c.imag) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+    }
+};
+}
+
+// 随机生成复数向量：同一种子生成同一向量
+Vector<Complex> generateRandomComplexVector(int n, uint64_t seed) {
     Vector<Complex> v;
-    srand(time(nullptr));
+    Xoshiro256 rng(seed);
     for (int i = 0; i < n; i++) {
-        double realPart = static_cast<double>(rand() % 100);
-        double imagPart = static_cast<double>(rand() % 100);
+        double realPart = static_cast<double>(rng.bounded(100));
+        double imagPart = static_cast<double>(rng.bounded(100));
         v.push_Back(Complex(realPart, imagPart));
     }
     return v;
@@ -42,7 +67,7 @@ Vector<Complex> generateRandomComplexVector(int n) {
 
 int main() {
     // 1. 生成随机复数向量
-    Vector<Complex> complexVector = generateRandomComplexVector(20);
+    Vector<Complex> complexVector = generateRandomComplexVector(20, time(nullptr));
 
     // 2. 测试无序向量的置乱、查找、插入、删除和唯一化操作
     std::cout << "Before shuffling: ";
@@ -77,6 +102,19 @@ int main() {
     complexVector.traverse([](Complex& c) { std::cout << "(" << c.real << "," << c.imag << ") "; });
     std::cout << std::endl;
 
+    // 批量删除：秩须升序且在[0,size)内，越界的秩表不能改动向量
+    Rank sizeBefore = complexVector.size();
+    Rank badRanks[] = {1, sizeBefore + 5};
+    try {
+        complexVector.removeIndices(badRanks, 2);
+        std::cout << "removeIndices with out-of-range ranks: size " << sizeBefore << " -> " << complexVector.size() << std::endl;
+    } catch (std::out_of_range const& e) {
+        std::cout << "removeIndices rejected out-of-range ranks: " << e.what() << std::endl;
+    }
+    Rank firstTwo[] = {0, 1};
+    complexVector.removeIndices(firstTwo, 2);
+    std::cout << "After removing indices 0 and 1: size " << sizeBefore << " -> " << complexVector.size() << std::endl;
+
     // 3. 测试排序效率
     Vector<Complex> orderedVector = complexVector;
     orderedVector.sort(3);
@@ -111,18 +149,31 @@ int main() {
     cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
     std::cout << "Time taken for merge sort on reversed vector: " << cpu_time_used << " seconds." << std::endl;
 
-    // 4. 实现区间查找算法
+    // 按模排序：每个复数只算一次模的平方，再对（键，秩）排序
+    Vector<Complex> keyedVector = complexVector;
+    start = clock();
+    keyedVector.sortByKey([](const Complex& c) { return c.norm(); });
+    end = clock();
+    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    std::cout << "Time taken for key sort by magnitude: " << cpu_time_used << " seconds." << std::endl;
+
+    // 4. 实现区间查找算法：orderedVector 已按模有序，二分定出模在[m1,m2)的区间，返回视图不复制
     double m1 = 5.0, m2 = 10.0;
-    Vector<Complex> subVector;
-    for (Rank i = 0; i < orderedVector.size(); i++) {
-        double mag = orderedVector[i].magnitude();
-        if (mag >= m1 && mag < m2) {
-            subVector.push_Back(orderedVector[i]);
-        }
-    }
+    VectorView<Complex> subVector =
+        orderedVector.range(m1 * m1, m2 * m2, [](const Complex& c) { return c.norm(); });
     std::cout << "Complex numbers with magnitude between " << m1 << " and " << m2 << ": ";
     subVector.traverse([](Complex& c) { std::cout << "(" << c.real << "," << c.imag << ") "; });
     std::cout << std::endl;
 
+    // 5. 按列存放的复数向量：按模排序、区间查找只扫描模平方一列
+    ComplexVector soa(complexVector.size());
+    auto toSoa = [&](Complex& c) { soa.push_Back(c.real, c.imag); };
+    complexVector.traverse(toSoa);
+    soa.sortByMagnitude();
+    ComplexVector soaSub = soa.rangeByMagnitude(m1, m2);
+    std::cout << "SoA: " << soaSub.size() << " complex numbers with magnitude between " << m1 << " and " << m2 << ": ";
+    soaSub.traverse([](double re, double im) { std::cout << "(" << re << "," << im << ") "; });
+    std::cout << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <cstdlib>
 #include <chrono>
 
+#include "../../00/Random.h"
+
 template <typename T>
 class Vector {
 protected:
@@ -21,8 +23,9 @@ protected:
     int max(int lo, int hi);
     void selectionSort(int lo, int hi);
 
-    void merge(int lo, int mi, int hi);
+    void merge(int lo, int mi, int hi, T* B);
     void mergeSort(int lo, int hi);
+    void mergeSort(int lo, int hi, T* B);
 
     int partition(int lo, int hi);
     void quickSort(int lo, int hi);
@@ -137,9 +140,20 @@ int Vector<T>::find(T const& e, int lo, int hi) const {
     return hi;
 }
 
+template <typename T>
+int Vector<T>::search(T const& e) const {
+    return search(e, 0, _size);
+}
+
 template <typename T>
 int Vector<T>::search(T const& e, int lo, int hi) const {
-    return -1;
+    int l = lo, n = hi - lo;
+    while (n > 0) {
+        int half = n / 2;
+        if (_elem[l + half] < e) { l += half + 1; n -= half + 1; }
+        else n = half;
+    }
+    return (l < hi && !(e < _elem[l])) ? l : -1;
 }
 
 template <typename T>
@@ -242,9 +256,10 @@ void Vector<T>::shrink() {
 template <typename T>
 void Vector<T>::unsort(int lo, int hi) {
     T* V = _elem + lo;
-    for (int i = lo; i < hi; i++) {
-        int j = rand() % (hi - lo) + lo;
-        std::swap(V[i], V[j]);
+    Xoshiro256& rng = Xoshiro256::local();
+    for (int i = hi - lo; i > 1; i--) {  // Fisher-Yates
+        int j = (int)rng.bounded(i);
+        std::swap(V[i - 1], V[j]);
     }
 }
 
@@ -266,24 +281,30 @@ void Vector<T>::bubbleSort(int lo, int hi) {
 }
 
 template <typename T>
-void Vector<T>::merge(int lo, int mi, int hi) {
-    T* temp = new T[hi - lo];
-    int i = lo, j = mi, k = 0;
-    while (i < mi && j < hi) {
-        if (_elem[i] < _elem[j]) temp[k++] = _elem[i++];
-        else temp[k++] = _elem[j++];
+void Vector<T>::merge(int lo, int mi, int hi, T* B) {
+    T* A = _elem + lo;
+    int lb = mi - lo, lc = hi - mi;
+    T* C = _elem + mi;
+    for (int i = 0; i < lb; i++) B[i] = A[i];
+    for (int i = 0, j = 0, k = 0; j < lb; ) {
+        if (k >= lc || !(C[k] < B[j])) A[i++] = B[j++];  // 相等时取前子向量，保证稳定
+        else A[i++] = C[k++];
     }
-    while (i < mi) temp[k++] = _elem[i++];
-    while (j < hi) temp[k++] = _elem[j++];
-    for (int l = lo; l < hi; l++) _elem[l] = temp[l - lo];
-    delete[] temp;
 }
 
 template <typename T>
 void Vector<T>::mergeSort(int lo, int hi) {
+    if (hi - lo < 2) return;
+    T* B = new T[(hi - lo) / 2];
+    mergeSort(lo, hi, B);
+    delete[] B;
+}
+
+template <typename T>
+void Vector<T>::mergeSort(int lo, int hi, T* B) {
     if (hi - lo < 2) return;
     int mi = (hi + lo) / 2;
-    mergeSort(lo, mi);
-    mergeSort(mi, hi);
-    merge(lo, mi, hi);
+    mergeSort(lo, mi, B);
+    mergeSort(mi, hi, B);
+    if (_elem[mi] < _elem[mi - 1]) merge(lo, mi, hi, B);
 }
\ No newline at end of file
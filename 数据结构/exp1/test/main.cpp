@@ -55,18 +55,18 @@ int main() {
     std::cout << "输入复数向量数量：";
     std::cin >> size_v;
 
-    srand(static_cast<unsigned int>(time(nullptr)));
+    Xoshiro256 rng(static_cast<uint64_t>(time(nullptr)));
 
     Complex defaultComplex;
     int num = size_v;
     Vector<Complex> complex_vector(num, 0, defaultComplex);
     for (int i = 0; i < num; i++) {
-        Complex new_complex = Complex(double(rand() % 100) / 10, double(rand() % 100) / 10);
+        Complex new_complex = Complex(double(rng.bounded(100)) / 10, double(rng.bounded(100)) / 10);
         complex_vector.push_Back(new_complex);
     }
 
     for (int i = 0; i < num / 3; i++) {
-        complex_vector[i] = complex_vector[rand() % num];
+        complex_vector[i] = complex_vector[rng.bounded(num)];
     }
 
     std::cout << "\n生成复数向量: \n";
@@ -79,7 +79,7 @@ int main() {
     std::cout << std::endl;
 
     std::cout << "查找： \n";
-    int chose_index = rand() % num;
+    int chose_index = rng.bounded(num);
     std::cout << "choose :" << complex_vector[chose_index].real << "+" << complex_vector[chose_index].imag << "i" << std::endl;
     Complex same_complex = Complex(complex_vector[chose_index].real, complex_vector[chose_index].imag);
     int place = complex_vector.find(same_complex);
@@ -87,16 +87,16 @@ int main() {
     std::cout << std::endl;
 
     std::cout << "\n插入: \n";
-    Complex new_complex = Complex(rand() % 10, rand() % 10);
+    Complex new_complex = Complex(rng.bounded(10), rng.bounded(10));
     std::cout << "new :" << new_complex.real << "+" << new_complex.imag << "i" << std::endl;
-    place = rand() % num;
+    place = rng.bounded(num);
     std::cout << "insert_place :" << place << std::endl;
     complex_vector.insert(place, new_complex);
     complex_vector.traverse(print);
     std::cout << std::endl;
 
     std::cout << "\n删除: \n";
-    place = rand() % num;
+    place = rng.bounded(num);
     std::cout << "delete :" << complex_vector[place].real << "+" << complex_vector[place].imag << "i" << std::endl;
     std::cout << "delete_place :" << place << std::endl;
     complex_vector.remove(place);
@@ -152,8 +152,8 @@ int main() {
     std::cout << std::endl;
 
     std::cout << "\n区间查找: \n";
-    Complex min = complex_vector[rand() % (complex_vector.size() / 2)];
-    Complex max = complex_vector[complex_vector.size() / 2 + rand() % (complex_vector.size() / 2)];
+    Complex min = complex_vector[rng.bounded(complex_vector.size() / 2)];
+    Complex max = complex_vector[complex_vector.size() / 2 + rng.bounded(complex_vector.size() / 2)];
 
     std::cout << "min :" << min.real << "+" << min.imag << "i       " << "max :" << max.real << "+" << max.imag << "i" << std::endl;
     Vector<Complex> interval_vector(0, 0, defaultComplex);